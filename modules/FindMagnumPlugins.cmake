@@ -38,6 +38,8 @@
 #
 #  OpenDdl                      - OpenDDL parser, used as a base for the
 #   OpenGexImporter plugin
+#  StanfordSceneConverter       - Stanford PLY writer, built together with
+#   the StanfordImporter plugin
 #
 # Example usage with specifying the plugins is::
 #
@@ -100,7 +102,7 @@ set(_MAGNUMPLUGINS_DEPENDENCIES )
 foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
     if(_component MATCHES ".+AudioImporter$")
         set(_MAGNUMPLUGINS_${_component}_MAGNUM_DEPENDENCIES Audio)
-    elseif(_component MATCHES ".+(Importer|ImageConverter)")
+    elseif(_component MATCHES ".+(Importer|ImageConverter)" OR _component STREQUAL StanfordSceneConverter)
         set(_MAGNUMPLUGINS_${_component}_MAGNUM_DEPENDENCIES Trade)
     elseif(_component MATCHES ".+(Font|FontConverter)$")
         set(_MAGNUMPLUGINS_${_component}_MAGNUM_DEPENDENCIES Text)
@@ -129,7 +131,7 @@ mark_as_advanced(MAGNUMPLUGINS_INCLUDE_DIR)
 
 # Component distinction (listing them explicitly to avoid mistakes with finding
 # components from other repositories)
-set(_MAGNUMPLUGINS_LIBRARY_COMPONENT_LIST OpenDdl)
+set(_MAGNUMPLUGINS_LIBRARY_COMPONENT_LIST OpenDdl StanfordSceneConverter)
 set(_MAGNUMPLUGINS_PLUGIN_COMPONENT_LIST
     AssimpImporter DdsImporter DevIlImageImporter
     DrFlacAudioImporter DrWavAudioImporter FreeTypeFont HarfBuzzFont
@@ -190,6 +192,11 @@ foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
             set(_MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_PATH_SUFFIX Magnum/${_component})
             set(_MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_PATH_NAMES ${_component}.h)
 
+            # The PLY writer is installed next to the importer plugin
+            if(_component STREQUAL StanfordSceneConverter)
+                set(_MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_PATH_SUFFIX MagnumPlugins/StanfordImporter)
+            endif()
+
             # Try to find both debug and release version
             find_library(MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_DEBUG Magnum${_component}-d)
             find_library(MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_RELEASE Magnum${_component})
@@ -364,14 +371,29 @@ foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
                 set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
                     INTERFACE_LINK_LIBRARIES ${PNG_LIBRARIES})
             endif()
-        endif()
 
-        # StanfordImporter has no dependencies
+        # StanfordImporter plugin dependencies
+        elseif(_component STREQUAL StanfordImporter)
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads REQUIRED)
+                set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
+
+        # No special setup for the StanfordSceneConverter library
         # StbImageConverter has no dependencies
         # StbImageImporter has no dependencies
         # StbTrueTypeFont has no dependencies
         # StbVorbisAudioImporter has no dependencies
-        # TinyGltfImporter has no dependencies
+
+        # TinyGltfImporter plugin dependencies
+        elseif(_component STREQUAL TinyGltfImporter)
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads REQUIRED)
+                set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
+        endif()
 
         # Find plugin/library includes
         if(_component MATCHES ${_MAGNUMPLUGINS_PLUGIN_COMPONENTS} OR _component MATCHES ${_MAGNUMPLUGINS_LIBRARY_COMPONENTS})
@@ -25,64 +25,68 @@
 
 #include "StanfordImporter.h"
 
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <unordered_map>
+#include <unordered_set>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/String.h>
 #include <Corrade/Utility/Endianness.h>
 #include <Magnum/Array.h>
 #include <Magnum/Mesh.h>
 #include <Magnum/Math/Color.h>
+#include <Magnum/Math/Constants.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/Trade/MeshData3D.h>
 
-namespace Magnum { namespace Trade {
-
-StanfordImporter::StanfordImporter() = default;
-
-StanfordImporter::StanfordImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
-
-StanfordImporter::~StanfordImporter() = default;
-
-auto StanfordImporter::doFeatures() const -> Features { return Feature::OpenData; }
+#include "MagnumPlugins/StanfordImporter/StanfordType.h"
 
-bool StanfordImporter::doIsOpened() const { return !!_in; }
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define MAGNUM_STANFORDIMPORTER_USE_MMAP
+#endif
 
-void StanfordImporter::doClose() { _in = nullptr; }
+/* MSVC doesn't define __SSE2__, but it's always available on x64 and with
+   /arch:SSE2 on x86 */
+#if defined(__AVX2__)
+#define MAGNUM_STANFORDIMPORTER_USE_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP == 2)
+#define MAGNUM_STANFORDIMPORTER_USE_SSE2
+#include <emmintrin.h>
+#endif
 
-void StanfordImporter::doOpenFile(const std::string& filename) {
-    /* Open file in *binary* mode to avoid broken binary data (need to handle \r manually) */
-    std::unique_ptr<std::istream> in{new std::ifstream{filename, std::ifstream::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
-    }
-
-    _in = std::move(in);
-}
-
-void StanfordImporter::doOpenData(const Containers::ArrayView<const char> data) {
-    _in.reset(new std::istringstream{{data, data.size()}});
-}
-
-UnsignedInt StanfordImporter::doMesh3DCount() const { return 1; }
+namespace Magnum { namespace Trade {
 
 namespace {
 
 enum class FileFormat {
     LittleEndian = 1,
-    BigEndian = 2
+    BigEndian = 2,
+    Ascii = 3
 };
 
-enum class Type {
-    UnsignedByte = 1,
-    Byte,
-    UnsignedShort,
-    Short,
-    UnsignedInt,
-    Int,
-    Float,
-    Double
-};
+/* File format matching the machine endianness, data in this format don't need
+   to be byte-swapped */
+constexpr FileFormat NativeFileFormat =
+    #ifndef CORRADE_TARGET_BIG_ENDIAN
+    FileFormat::LittleEndian
+    #else
+    FileFormat::BigEndian
+    #endif
+    ;
+
+typedef Implementation::StanfordType Type;
+using Implementation::parseStanfordType;
+using Implementation::stanfordTypeSize;
 
 enum class PropertyType {
     Vertex = 1,
@@ -90,137 +94,120 @@ enum class PropertyType {
     Ignored
 };
 
-Type parseType(const std::string& type) {
-    if(type == "uchar"  || type == "uint8")     return Type::UnsignedByte;
-    if(type == "char"   || type == "int8")      return Type::Byte;
-    if(type == "ushort" || type == "uint16")    return Type::UnsignedShort;
-    if(type == "short"  || type == "int16")     return Type::Short;
-    if(type == "uint"   || type == "uint32")    return Type::UnsignedInt;
-    if(type == "int"    || type == "int32")     return Type::Int;
-    if(type == "float"  || type == "float32")   return Type::Float;
-    if(type == "double" || type == "float64")   return Type::Double;
-
-    return {};
-}
-
-std::size_t sizeOf(Type type) {
-    switch(type) {
-        #define _c(type) case Type::type: return sizeof(type);
-        _c(UnsignedByte)
-        _c(Byte)
-        _c(UnsignedShort)
-        _c(Short)
-        _c(UnsignedInt)
-        _c(Int)
-        _c(Float)
-        _c(Double)
-        #undef _c
-    }
+/* What a vertex property is imported as */
+enum class VertexComponent: UnsignedByte {
+    Ignored,
+    PositionX,
+    PositionY,
+    PositionZ,
+    NormalX,
+    NormalY,
+    NormalZ,
+    TextureCoordinateU,
+    TextureCoordinateV,
+    ColorRed,
+    ColorGreen,
+    ColorBlue,
+    ColorAlpha
+};
 
-    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+VertexComponent parseVertexComponent(const std::string& name) {
+    if(name == "x")     return VertexComponent::PositionX;
+    if(name == "y")     return VertexComponent::PositionY;
+    if(name == "z")     return VertexComponent::PositionZ;
+    if(name == "nx")    return VertexComponent::NormalX;
+    if(name == "ny")    return VertexComponent::NormalY;
+    if(name == "nz")    return VertexComponent::NormalZ;
+    if(name == "u" || name == "s" || name == "texture_u" || name == "texture_s")
+        return VertexComponent::TextureCoordinateU;
+    if(name == "v" || name == "t" || name == "texture_v" || name == "texture_t")
+        return VertexComponent::TextureCoordinateV;
+    if(name == "red")   return VertexComponent::ColorRed;
+    if(name == "green") return VertexComponent::ColorGreen;
+    if(name == "blue")  return VertexComponent::ColorBlue;
+    if(name == "alpha") return VertexComponent::ColorAlpha;
+
+    return VertexComponent::Ignored;
 }
 
-template<FileFormat format, class T> struct EndianSwap;
-template<class T> struct EndianSwap<FileFormat::LittleEndian, T> {
-    constexpr T operator()(T value) const { return Utility::Endianness::littleEndian<T>(value); }
-};
-template<class T> struct EndianSwap<FileFormat::BigEndian, T> {
-    constexpr T operator()(T value) const { return Utility::Endianness::bigEndian<T>(value); }
+struct VertexProperty {
+    Type type;
+    VertexComponent component;
+    /* Offset from the start of a vertex, used only by binary files. ASCII
+       files rely just on the property order. */
+    UnsignedInt offset;
 };
 
-template<class T, FileFormat format, class U> inline T extractAndSkip(const char*& buffer) {
-    const auto result = T(EndianSwap<format, U>{}(*reinterpret_cast<const U*>(buffer)));
-    buffer += sizeof(U);
-    return result;
-}
+/* Everything parsed from the file header */
+struct Header {
+    FileFormat fileFormat;
+    UnsignedInt vertexCount, faceCount;
+    /* Size of a single vertex in binary files */
+    UnsignedInt vertexStride;
+    std::vector<VertexProperty> vertexProperties;
+    /* Whether there's a face element. If not, the file is a point cloud. */
+    bool hasFaces;
+    /* Whether there's at least one component of given attribute */
+    bool hasNormals, hasTextureCoordinates, hasColors;
+    Type faceSizeType, faceIndexType;
+    /* Offset of the vertex and face data from the start of the file */
+    std::size_t bodyOffset;
+};
 
-template<class T, FileFormat format> T extractAndSkip(const char*& buffer, const Type type) {
-    switch(type) {
-        #define _c(type) case Type::type: return extractAndSkip<T, format, type>(buffer);
-        _c(UnsignedByte)
-        _c(Byte)
-        _c(UnsignedShort)
-        _c(Short)
-        _c(UnsignedInt)
-        _c(Int)
-        _c(Float)
-        _c(Double)
-        #undef _c
+/* Equivalent of std::getline() operating on a view, advances the view past
+   the line */
+bool getline(Containers::ArrayView<const char>& in, std::string& line) {
+    if(in.empty()) return false;
+
+    const char* const end = static_cast<const char*>(std::memchr(in.data(), '\n', in.size()));
+    if(end) {
+        line.assign(in.data(), end);
+        in = in.suffix(end + 1 - in.data());
+    } else {
+        line.assign(in.begin(), in.end());
+        in = in.suffix(in.size());
     }
 
-    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-}
-
-template<class T> inline T extractAndSkip(const char*& buffer, const FileFormat fileFormat, const Type type) {
-    return fileFormat == FileFormat::LittleEndian ?
-        extractAndSkip<T, FileFormat::LittleEndian>(buffer, type) :
-        extractAndSkip<T, FileFormat::BigEndian>(buffer, type);
-}
-
-template<class T> inline T extract(const char* const buffer, const FileFormat fileFormat, const Type type) {
-    const char* mutableBuffer = buffer;
-    return extractAndSkip<T>(mutableBuffer, fileFormat, type);
-}
-
-inline void extractTriangle(std::vector<UnsignedInt>& indices, const char* const buffer, const FileFormat fileFormat, const Type indexType) {
-    const char* position = buffer;
-
-    indices.insert(indices.end(), {
-        extractAndSkip<UnsignedInt>(position, fileFormat, indexType),
-        extractAndSkip<UnsignedInt>(position, fileFormat, indexType),
-        extractAndSkip<UnsignedInt>(position, fileFormat, indexType)
-    });
-}
-
-inline void extractQuad(std::vector<UnsignedInt>& indices, const char* const buffer, const FileFormat fileFormat, const Type indexType) {
-    const char* position = buffer;
-
-    /* GCC <=4.8 doesn't properly sequence the operations in list-initializer
-       (e.g. Vector4ui{extractAndSkip(), extractAndSkip(), ...}, so I need to
-       make the order really explicit. From what I understood from the specs,
-       this should be defined when using {}. Am I right? */
-    Vector4ui quad{Math::NoInit};
-    quad[0] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
-    quad[1] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
-    quad[2] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
-    quad[3] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
-
-    /* 0 0---3
-       |\ \  |
-       | \ \ |
-       |  \ \|
-       1---2 2 */
-    indices.insert(indices.end(), {
-        quad[0],
-        quad[1],
-        quad[2],
-        quad[0],
-        quad[2],
-        quad[3]
-    });
+    return true;
 }
 
+/* Parses an element count, which has to be a plain decimal number fitting
+   into 32 bits. std::stoi() would throw on garbage and silently accept
+   negative or trailing characters. */
+bool parseCount(const std::string& string, UnsignedInt& out) {
+    /* strtoull() skips leading whitespace and accepts a sign, neither of
+       which is valid here */
+    if(string.empty() || string[0] < '0' || string[0] > '9') return false;
+
+    char* end;
+    errno = 0;
+    const unsigned long long value = std::strtoull(string.data(), &end, 10);
+    if(errno || end != string.data() + string.size() || value > 0xffffffffull)
+        return false;
+
+    out = UnsignedInt(value);
+    return true;
 }
 
-Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
-    _in->seekg(0);
+bool parseHeader(const char* const prefix, const Containers::ArrayView<const char> data, Header& out) {
+    Containers::ArrayView<const char> in = data;
 
     /* Check file signature */
     {
         std::string header;
-        std::getline(*_in, header);
+        getline(in, header);
         header = Utility::String::rtrim(std::move(header));
         if(header != "ply") {
-            Error() << "Trade::StanfordImporter::mesh3D(): invalid file signature" << header;
-            return Containers::NullOpt;
+            Error() << prefix << "invalid file signature" << header;
+            return false;
         }
     }
 
     /* Parse format line */
-    FileFormat fileFormat{};
+    out.fileFormat = {};
     {
         std::string line;
-        while(std::getline(*_in, line)) {
+        while(getline(in, line)) {
             std::vector<std::string> tokens = Utility::String::splitWithoutEmptyParts(line);
 
             /* Skip empty lines and comments */
@@ -228,46 +215,51 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
                 continue;
 
             if(tokens[0] != "format") {
-                Error() << "Trade::StanfordImporter::mesh3D(): expected format line";
-                return Containers::NullOpt;
+                Error() << prefix << "expected format line";
+                return false;
             }
 
             if(tokens.size() != 3) {
-                Error() << "Trade::StanfordImporter::mesh3D(): invalid format line" << line;
-                return Containers::NullOpt;
+                Error() << prefix << "invalid format line" << line;
+                return false;
             }
 
             if(tokens[2] == "1.0") {
                 if(tokens[1] == "binary_little_endian") {
-                    fileFormat = FileFormat::LittleEndian;
+                    out.fileFormat = FileFormat::LittleEndian;
                     break;
                 } else if(tokens[1] == "binary_big_endian") {
-                    fileFormat = FileFormat::BigEndian;
+                    out.fileFormat = FileFormat::BigEndian;
+                    break;
+                } else if(tokens[1] == "ascii") {
+                    out.fileFormat = FileFormat::Ascii;
                     break;
                 }
             }
 
-            Error() << "Trade::StanfordImporter::mesh3D(): unsupported file format" << tokens[1] << tokens[2];
-            return Containers::NullOpt;
+            Error() << prefix << "unsupported file format" << tokens[1] << tokens[2];
+            return false;
         }
     }
 
     /* Check format line consistency */
-    if(fileFormat == FileFormat{}) {
-        Error() << "Trade::StanfordImporter::mesh3D(): missing format line";
-        return Containers::NullOpt;
+    if(out.fileFormat == FileFormat{}) {
+        Error() << prefix << "missing format line";
+        return false;
     }
 
     /* Parse rest of the header */
-    UnsignedInt stride{}, vertexCount{}, faceCount{};
-    Array3D<Type> componentTypes;
-    Type faceSizeType{}, faceIndexType{};
-    Vector3i componentOffsets{-1};
+    out.vertexCount = out.faceCount = 0;
+    out.hasFaces = false;
+    out.vertexProperties.clear();
+    out.hasNormals = out.hasTextureCoordinates = out.hasColors = false;
+    out.faceSizeType = out.faceIndexType = Type{};
+    Math::BoolVector<3> hasPositionComponents;
     {
-        std::size_t componentOffset = 0;
+        UnsignedInt componentOffset = 0;
         std::string line;
         PropertyType propertyType{};
-        while(std::getline(*_in, line)) {
+        while(getline(in, line)) {
             std::vector<std::string> tokens = Utility::String::splitWithoutEmptyParts(line);
 
             /* Skip empty lines and comments */
@@ -278,18 +270,25 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
             if(tokens[0] == "element") {
                 /* Vertex elements */
                 if(tokens.size() == 3 && tokens[1] == "vertex") {
-                    vertexCount = std::stoi(tokens[2]);
+                    if(!parseCount(tokens[2], out.vertexCount)) {
+                        Error() << prefix << "invalid vertex count" << tokens[2];
+                        return false;
+                    }
                     propertyType = PropertyType::Vertex;
 
                 /* Face elements */
                 } else if(tokens.size() == 3 &&tokens[1] == "face") {
-                    faceCount = std::stoi(tokens[2]);
+                    if(!parseCount(tokens[2], out.faceCount)) {
+                        Error() << prefix << "invalid face count" << tokens[2];
+                        return false;
+                    }
+                    out.hasFaces = true;
                     propertyType = PropertyType::Face;
 
                 /* Something else */
                 } else {
-                    Error() << "Trade::StanfordImporter::mesh3D(): unknown element" << tokens[1];
-                    return Containers::NullOpt;
+                    Error() << prefix << "unknown element" << tokens[1];
+                    return false;
                 }
 
             /* Element properties */
@@ -297,56 +296,57 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
                 /* Vertex element properties */
                 if(propertyType == PropertyType::Vertex) {
                     if(tokens.size() != 3) {
-                        Error() << "Trade::StanfordImporter::mesh3D(): invalid vertex property line" << line;
-                        return Containers::NullOpt;
+                        Error() << prefix << "invalid vertex property line" << line;
+                        return false;
                     }
 
                     /* Component type */
-                    const Type componentType = parseType(tokens[1]);
+                    const Type componentType = parseStanfordType(tokens[1]);
                     if(componentType == Type{}) {
-                        Error() << "Trade::StanfordImporter::mesh3D(): invalid vertex component type" << tokens[1];
-                        return Containers::NullOpt;
+                        Error() << prefix << "invalid vertex component type" << tokens[1];
+                        return false;
                     }
 
                     /* Component */
-                    if(tokens[2] == "x") {
-                        componentOffsets.x() = componentOffset;
-                        componentTypes.x() = componentType;
-                    } else if(tokens[2] == "y") {
-                        componentOffsets.y() = componentOffset;
-                        componentTypes.y() = componentType;
-                    } else if(tokens[2] == "z") {
-                        componentOffsets.z() = componentOffset;
-                        componentTypes.z() = componentType;
-                    }
-                    else Debug() << "Trade::StanfordImporter::mesh3D(): ignoring unknown vertex component" << tokens[2];
+                    const VertexComponent component = parseVertexComponent(tokens[2]);
+                    if(component == VertexComponent::Ignored)
+                        Debug() << prefix << "ignoring unknown vertex component" << tokens[2];
+                    else if(component <= VertexComponent::PositionZ)
+                        hasPositionComponents.set(UnsignedByte(component) - UnsignedByte(VertexComponent::PositionX), true);
+                    else if(component <= VertexComponent::NormalZ)
+                        out.hasNormals = true;
+                    else if(component <= VertexComponent::TextureCoordinateV)
+                        out.hasTextureCoordinates = true;
+                    else out.hasColors = true;
+
+                    out.vertexProperties.push_back({componentType, component, componentOffset});
 
                     /* Add size of current component to total offset */
-                    componentOffset += sizeOf(componentType);
+                    componentOffset += stanfordTypeSize(componentType);
 
                 /* Face element properties */
                 } else if(propertyType == PropertyType::Face) {
                     if(tokens.size() != 5 || tokens[1] != "list" || tokens[4] != "vertex_indices") {
-                        Error() << "Trade::StanfordImporter::mesh3D(): unknown face property line" << line;
-                        return Containers::NullOpt;
+                        Error() << prefix << "unknown face property line" << line;
+                        return false;
                     }
 
                     /* Face size type */
-                    if((faceSizeType = parseType(tokens[2])) == Type{}) {
-                        Error() << "Trade::StanfordImporter::mesh3D(): invalid face size type" << tokens[2];
-                        return Containers::NullOpt;
+                    if((out.faceSizeType = parseStanfordType(tokens[2])) == Type{}) {
+                        Error() << prefix << "invalid face size type" << tokens[2];
+                        return false;
                     }
 
                     /* Face index type */
-                    if((faceIndexType = parseType(tokens[3])) == Type{}) {
-                        Error() << "Trade::StanfordImporter::mesh3D(): invalid face index type" << tokens[3];
-                        return Containers::NullOpt;
+                    if((out.faceIndexType = parseStanfordType(tokens[3])) == Type{}) {
+                        Error() << prefix << "invalid face index type" << tokens[3];
+                        return false;
                     }
 
                 /* Unexpected property line */
                 } else if(propertyType != PropertyType::Ignored) {
-                    Error() << "Trade::StanfordImporter::mesh3D(): unexpected property line";
-                    return Containers::NullOpt;
+                    Error() << prefix << "unexpected property line";
+                    return false;
                 }
 
             /* Header end */
@@ -355,69 +355,1261 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
 
             /* Something else */
             } else {
-                Error() << "Trade::StanfordImporter::mesh3D(): unknown line" << line;
-                return Containers::NullOpt;
+                Error() << prefix << "unknown line" << line;
+                return false;
             }
         }
 
-        stride = componentOffset;
+        out.vertexStride = componentOffset;
     }
 
     /* Check header consistency */
-    if((componentOffsets < Vector3i{0}).any()) {
-        Error() << "Trade::StanfordImporter::mesh3D(): incomplete vertex specification";
-        return Containers::NullOpt;
+    if(!hasPositionComponents.all()) {
+        Error() << prefix << "incomplete vertex specification";
+        return false;
     }
-    if(faceSizeType == Type{} || faceIndexType == Type{}) {
-        Error() << "Trade::StanfordImporter::mesh3D(): incomplete face specification";
-        return Containers::NullOpt;
+    if(out.hasFaces && (out.faceSizeType == Type{} || out.faceIndexType == Type{})) {
+        Error() << prefix << "incomplete face specification";
+        return false;
     }
 
-    /* Parse vertices */
-    std::vector<Vector3> positions;
-    positions.reserve(vertexCount);
-    {
-        Containers::Array<char> buffer{stride};
-        for(std::size_t i = 0; i != vertexCount; ++i) {
-            _in->read(buffer, stride);
-            positions.emplace_back(
-                extract<Float>(buffer + componentOffsets.x(), fileFormat, componentTypes.x()),
-                extract<Float>(buffer + componentOffsets.y(), fileFormat, componentTypes.y()),
-                extract<Float>(buffer + componentOffsets.z(), fileFormat, componentTypes.z())
-            );
+    out.bodyOffset = in.data() - data.data();
+    return true;
+}
+
+void fillDefaultConfiguration(Utility::ConfigurationGroup& conf) {
+    /** @todo horrible workaround, fix this properly */
+    conf.setValue("threads", 1);
+    conf.setValue("pointCloudBatchSize", 0);
+    conf.setValue("pointCloudVoxelSize", 0.0f);
+    conf.setValue("weld", false);
+    conf.setValue("weldTolerance", 0.0f);
+}
+
+/* Count of vertices in a single point cloud batch or 0 if the file should be
+   imported as a single mesh */
+std::size_t pointCloudBatchSize(const Header& header, const Utility::ConfigurationGroup& conf) {
+    if(header.hasFaces) return 0;
+    return conf.value<std::size_t>("pointCloudBatchSize");
+}
+
+}
+
+struct StanfordImporter::State {
+    #ifdef MAGNUM_STANFORDIMPORTER_USE_MMAP
+    /* Populated if the file was opened through openFile() */
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped;
+    #endif
+
+    /* Populated if the file was opened through openData() or read through
+       openFile() on platforms without memory mapping */
+    Containers::Array<char> copied;
+
+    /* View on either of the above */
+    Containers::ArrayView<const char> data;
+
+    /* Parsed once on opening, so the mesh import doesn't need to do it
+       again */
+    Header header;
+
+    /* Vertex after the last imported batch of an ASCII point cloud and its
+       offset in the file, so importing the batches in order doesn't need to
+       tokenize the file from the start every time */
+    std::size_t asciiNextVertex{}, asciiNextVertexOffset{};
+};
+
+StanfordImporter::StanfordImporter() {
+    /** @todo horrible workaround, fix this properly */
+    fillDefaultConfiguration(configuration());
+}
+
+StanfordImporter::StanfordImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+StanfordImporter::~StanfordImporter() = default;
+
+auto StanfordImporter::doFeatures() const -> Features { return Feature::OpenData; }
+
+bool StanfordImporter::doIsOpened() const { return !!_state; }
+
+void StanfordImporter::doClose() { _state = nullptr; }
+
+void StanfordImporter::doOpenFile(const std::string& filename) {
+    std::unique_ptr<State> state{new State};
+
+    #ifdef MAGNUM_STANFORDIMPORTER_USE_MMAP
+    /* Map the file instead of reading it, so the (potentially huge) vertex
+       and face data are never copied */
+    state->mapped = Utility::Directory::mapRead(filename);
+    if(!state->mapped) {
+        Error() << "Trade::StanfordImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+    state->data = state->mapped;
+    #else
+    /* Not delegating to AbstractImporter::doOpenFile() so the header errors
+       are reported with the function the user actually called and the file
+       contents don't get copied a second time in doOpenData() */
+    if(!Utility::Directory::fileExists(filename)) {
+        Error() << "Trade::StanfordImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+    state->copied = Utility::Directory::read(filename);
+    state->data = state->copied;
+    #endif
+
+    if(!parseHeader("Trade::StanfordImporter::openFile():", state->data, state->header)) return;
+    _state = std::move(state);
+}
+
+void StanfordImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    /* The data are not guaranteed to be in scope after this function exits,
+       so we need to make a copy */
+    std::unique_ptr<State> state{new State};
+    if(!parseHeader("Trade::StanfordImporter::openData():", data, state->header)) return;
+    state->copied = Containers::Array<char>{Containers::NoInit, data.size()};
+    std::copy(data.begin(), data.end(), state->copied.begin());
+    state->data = state->copied;
+    _state = std::move(state);
+}
+
+UnsignedInt StanfordImporter::doMesh3DCount() const {
+    const std::size_t batchSize = pointCloudBatchSize(_state->header, configuration());
+    if(!batchSize) return 1;
+    return std::max(std::size_t{1}, (_state->header.vertexCount + batchSize - 1)/batchSize);
+}
+
+namespace {
+
+template<FileFormat format, class T> struct EndianSwap;
+template<class T> struct EndianSwap<FileFormat::LittleEndian, T> {
+    constexpr T operator()(T value) const { return Utility::Endianness::littleEndian<T>(value); }
+};
+template<class T> struct EndianSwap<FileFormat::BigEndian, T> {
+    constexpr T operator()(T value) const { return Utility::Endianness::bigEndian<T>(value); }
+};
+
+template<class T, FileFormat format, class U> inline T extractAndSkip(const char*& buffer) {
+    /* The data are read directly from the file and thus can be arbitrarily
+       aligned, memcpy() is the only portable way to read them */
+    U value;
+    std::memcpy(&value, buffer, sizeof(U));
+    const auto result = T(EndianSwap<format, U>{}(value));
+    buffer += sizeof(U);
+    return result;
+}
+
+template<class T, FileFormat format> T extractAndSkip(const char*& buffer, const Type type) {
+    switch(type) {
+        #define _c(type) case Type::type: return extractAndSkip<T, format, type>(buffer);
+        _c(UnsignedByte)
+        _c(Byte)
+        _c(UnsignedShort)
+        _c(Short)
+        _c(UnsignedInt)
+        _c(Int)
+        _c(Float)
+        _c(Double)
+        #undef _c
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<class T> inline T extractAndSkip(const char*& buffer, const FileFormat fileFormat, const Type type) {
+    return fileFormat == FileFormat::LittleEndian ?
+        extractAndSkip<T, FileFormat::LittleEndian>(buffer, type) :
+        extractAndSkip<T, FileFormat::BigEndian>(buffer, type);
+}
+
+template<class T> inline T extract(const char* const buffer, const FileFormat fileFormat, const Type type) {
+    const char* mutableBuffer = buffer;
+    return extractAndSkip<T>(mutableBuffer, fileFormat, type);
+}
+
+/* Batch byte swapping. The SIMD variants process as much as possible and
+   leave the rest for the scalar loop at the end. */
+inline void byteSwapInPlace(UnsignedByte*, std::size_t) {}
+
+void byteSwapInPlace(UnsignedShort* data, const std::size_t count) {
+    std::size_t i = 0;
+
+    #if defined(MAGNUM_STANFORDIMPORTER_USE_AVX2)
+    const __m256i shuffle = _mm256_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for(; i + 16 <= count; i += 16) {
+        __m256i* const p = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), shuffle));
+    }
+    #elif defined(MAGNUM_STANFORDIMPORTER_USE_SSE2)
+    for(; i + 8 <= count; i += 8) {
+        __m128i* const p = reinterpret_cast<__m128i*>(data + i);
+        const __m128i v = _mm_loadu_si128(p);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+    #endif
+
+    for(; i != count; ++i) data[i] = Utility::Endianness::swap(data[i]);
+}
+
+void byteSwapInPlace(UnsignedInt* data, const std::size_t count) {
+    std::size_t i = 0;
+
+    #if defined(MAGNUM_STANFORDIMPORTER_USE_AVX2)
+    const __m256i shuffle = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    for(; i + 8 <= count; i += 8) {
+        __m256i* const p = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), shuffle));
+    }
+    #elif defined(MAGNUM_STANFORDIMPORTER_USE_SSE2)
+    /* Swap bytes in each 16-bit word, then the words in each 32-bit value */
+    for(; i + 4 <= count; i += 4) {
+        __m128i* const p = reinterpret_cast<__m128i*>(data + i);
+        __m128i v = _mm_loadu_si128(p);
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128(p, v);
+    }
+    #endif
+
+    for(; i != count; ++i) data[i] = Utility::Endianness::swap(data[i]);
+}
+
+void byteSwapInPlace(UnsignedLong* data, const std::size_t count) {
+    std::size_t i = 0;
+
+    #if defined(MAGNUM_STANFORDIMPORTER_USE_AVX2)
+    const __m256i shuffle = _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    for(; i + 4 <= count; i += 4) {
+        __m256i* const p = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), shuffle));
+    }
+    #elif defined(MAGNUM_STANFORDIMPORTER_USE_SSE2)
+    /* Swap bytes in each 16-bit word, then reverse the words in each 64-bit
+       value */
+    for(; i + 2 <= count; i += 2) {
+        __m128i* const p = reinterpret_cast<__m128i*>(data + i);
+        __m128i v = _mm_loadu_si128(p);
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_storeu_si128(p, v);
+    }
+    #endif
+
+    for(; i != count; ++i) data[i] = Utility::Endianness::swap(data[i]);
+}
+
+template<std::size_t> struct UnsignedTypeFor;
+template<> struct UnsignedTypeFor<1> { typedef UnsignedByte Type; };
+template<> struct UnsignedTypeFor<2> { typedef UnsignedShort Type; };
+template<> struct UnsignedTypeFor<4> { typedef UnsignedInt Type; };
+template<> struct UnsignedTypeFor<8> { typedef UnsignedLong Type; };
+
+/* Dispatches signed and floating-point types to the above */
+template<class T> inline void byteSwapInPlace(T* data, const std::size_t count) {
+    byteSwapInPlace(reinterpret_cast<typename UnsignedTypeFor<sizeof(T)>::Type*>(data), count);
+}
+
+/* Number of elements processed at once in the batch conversion functions
+   below, chosen so the temporary buffers comfortably fit into L1 cache */
+constexpr std::size_t BatchSize = 512;
+
+/* Copies positions composed of three consecutive components of the same
+   type. The components are gathered into a batch, byte-swapped at once if
+   needed and then converted to floats. */
+template<class T> void copyPositions(const Containers::ArrayView<Vector3> out, const char* in, const std::size_t stride, const FileFormat fileFormat) {
+    T buffer[BatchSize*3];
+    for(std::size_t offset = 0; offset < out.size(); offset += BatchSize) {
+        const std::size_t count = std::min(BatchSize, out.size() - offset);
+        for(std::size_t i = 0; i != count; ++i, in += stride)
+            std::memcpy(buffer + i*3, in, sizeof(T)*3);
+
+        if(fileFormat != NativeFileFormat) byteSwapInPlace(buffer, count*3);
+
+        for(std::size_t i = 0; i != count; ++i)
+            out[offset + i] = Vector3{Float(buffer[i*3 + 0]),
+                                      Float(buffer[i*3 + 1]),
+                                      Float(buffer[i*3 + 2])};
+    }
+}
+
+/* Floats don't need any conversion, so they are copied directly to the
+   output (in a single block if there is nothing else in the vertex) and
+   swapped there */
+template<> void copyPositions<Float>(const Containers::ArrayView<Vector3> out, const char* in, const std::size_t stride, const FileFormat fileFormat) {
+    static_assert(sizeof(Vector3) == 12, "Vector3 is not tightly packed");
+    if(stride == sizeof(Vector3))
+        std::copy(in, in + out.size()*sizeof(Vector3), reinterpret_cast<char*>(out.data()));
+    else for(Vector3& i: out) {
+        std::memcpy(&i, in, sizeof(Vector3));
+        in += stride;
+    }
+
+    if(fileFormat != NativeFileFormat)
+        byteSwapInPlace(reinterpret_cast<Float*>(out.data()), out.size()*3);
+}
+
+/* Copies consecutive triangle faces with an 8-bit face size. Stops at the
+   first face that is not a triangle or is truncated and returns number of
+   faces copied. The indices are processed the same way as positions above. */
+template<class T> std::size_t copyTriangles(UnsignedInt* const out, const std::size_t faceCount, const char*& position, const char* const end, const FileFormat fileFormat) {
+    constexpr std::size_t FaceSize = 1 + 3*sizeof(T);
+    T buffer[BatchSize*3];
+    std::size_t offset = 0;
+    for(;;) {
+        std::size_t count = 0;
+        for(; count != BatchSize && offset + count != faceCount && std::size_t(end - position) >= FaceSize && *position == 3; ++count, position += FaceSize)
+            std::memcpy(buffer + count*3, position + 1, sizeof(T)*3);
+
+        if(fileFormat != NativeFileFormat) byteSwapInPlace(buffer, count*3);
+
+        std::copy(buffer, buffer + count*3, out + offset*3);
+        offset += count;
+        if(count != BatchSize) return offset;
+    }
+}
+
+/* 32-bit indices are again copied directly to the output and swapped
+   there */
+template<> std::size_t copyTriangles<UnsignedInt>(UnsignedInt* const out, const std::size_t faceCount, const char*& position, const char* const end, const FileFormat fileFormat) {
+    std::size_t offset = 0;
+    for(; offset != faceCount && end - position >= 13 && *position == 3; ++offset, position += 13)
+        std::memcpy(out + offset*3, position + 1, 12);
+
+    if(fileFormat != NativeFileFormat) byteSwapInPlace(out, offset*3);
+
+    return offset;
+}
+
+inline void extractTriangle(UnsignedInt* const out, const char* const buffer, const FileFormat fileFormat, const Type indexType) {
+    const char* position = buffer;
+
+    out[0] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
+    out[1] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
+    out[2] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
+}
+
+inline void extractQuad(UnsignedInt* const out, const char* const buffer, const FileFormat fileFormat, const Type indexType) {
+    const char* position = buffer;
+
+    /* GCC <=4.8 doesn't properly sequence the operations in list-initializer
+       (e.g. Vector4ui{extractAndSkip(), extractAndSkip(), ...}, so I need to
+       make the order really explicit. From what I understood from the specs,
+       this should be defined when using {}. Am I right? */
+    Vector4ui quad{Math::NoInit};
+    quad[0] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
+    quad[1] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
+    quad[2] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
+    quad[3] = extractAndSkip<UnsignedInt>(position, fileFormat, indexType);
+
+    /* 0 0---3
+       |\ \  |
+       | \ \ |
+       |  \ \|
+       1---2 2 */
+    out[0] = quad[0];
+    out[1] = quad[1];
+    out[2] = quad[2];
+    out[3] = quad[0];
+    out[4] = quad[2];
+    out[5] = quad[3];
+}
+
+/* Vertex attributes imported from the file */
+struct VertexAttributes {
+    std::vector<Vector3> positions, normals;
+    std::vector<Vector2> textureCoordinates;
+    std::vector<Color4> colors;
+};
+
+/* Where to put a decoded vertex property */
+struct VertexTarget {
+    /* Output array or nullptr if the property is ignored */
+    Float* out;
+    /* Vertex size in the output array and component index in the vertex,
+       both in floats */
+    UnsignedByte stride, component;
+    Type type;
+    /* Offset of the property in the binary vertex record */
+    UnsignedInt offset;
+    /* Multiplier for the decoded value, used to normalize integer colors */
+    Float scale;
+};
+
+Float normalizationScale(const Type type) {
+    switch(type) {
+        #define _c(type) case Type::type: return 1.0f/Float(std::numeric_limits<type>::max());
+        _c(UnsignedByte)
+        _c(Byte)
+        _c(UnsignedShort)
+        _c(Short)
+        _c(UnsignedInt)
+        _c(Int)
+        #undef _c
+        case Type::Float:
+        case Type::Double:
+            return 1.0f;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+VertexTarget vertexTarget(VertexAttributes& attributes, const VertexProperty& property) {
+    const UnsignedByte component = UnsignedByte(property.component);
+    if(property.component == VertexComponent::Ignored)
+        return {nullptr, 0, 0, property.type, property.offset, 1.0f};
+    if(property.component <= VertexComponent::PositionZ)
+        return {reinterpret_cast<Float*>(attributes.positions.data()), 3, UnsignedByte(component - UnsignedByte(VertexComponent::PositionX)), property.type, property.offset, 1.0f};
+    if(property.component <= VertexComponent::NormalZ)
+        return {reinterpret_cast<Float*>(attributes.normals.data()), 3, UnsignedByte(component - UnsignedByte(VertexComponent::NormalX)), property.type, property.offset, 1.0f};
+    if(property.component <= VertexComponent::TextureCoordinateV)
+        return {reinterpret_cast<Float*>(attributes.textureCoordinates.data()), 2, UnsignedByte(component - UnsignedByte(VertexComponent::TextureCoordinateU)), property.type, property.offset, 1.0f};
+    return {reinterpret_cast<Float*>(attributes.colors.data()), 4, UnsignedByte(component - UnsignedByte(VertexComponent::ColorRed)), property.type, property.offset, normalizationScale(property.type)};
+}
+
+/* Decodes all given properties in a single pass over the vertex records */
+void extractVertexProperties(const std::vector<VertexTarget>& targets, const char* position, const std::size_t vertexCount, const UnsignedInt stride, const FileFormat fileFormat) {
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        for(const VertexTarget& target: targets)
+            target.out[i*target.stride + target.component] = extract<Float>(position + target.offset, fileFormat, target.type)*target.scale;
+        position += stride;
+    }
+}
+
+MeshData3D meshData(std::vector<UnsignedInt>&& indices, VertexAttributes&& attributes, const Header& header) {
+    /* Files without faces are point clouds */
+    const MeshPrimitive primitive = header.hasFaces ?
+        MeshPrimitive::Triangles : MeshPrimitive::Points;
+
+    std::vector<std::vector<Vector3>> normals;
+    std::vector<std::vector<Vector2>> textureCoordinates;
+    std::vector<std::vector<Color4>> colors;
+    if(header.hasNormals) normals.push_back(std::move(attributes.normals));
+    if(header.hasTextureCoordinates) textureCoordinates.push_back(std::move(attributes.textureCoordinates));
+    if(header.hasColors) colors.push_back(std::move(attributes.colors));
+
+    return MeshData3D{primitive, std::move(indices), {std::move(attributes.positions)}, std::move(normals), std::move(textureCoordinates), std::move(colors), nullptr};
+}
+
+/* Whether triangles can be converted in batches by copyTriangles(), which
+   is if the face size is a single byte and the indices are 16- or 32-bit */
+inline bool canCopyTriangles(const UnsignedInt faceSizeTypeSize, const UnsignedInt faceIndexTypeSize) {
+    return faceSizeTypeSize == 1 && (faceIndexTypeSize == 2 || faceIndexTypeSize == 4);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+/* Don't bother spawning threads for less faces than this */
+constexpr std::size_t MinFacesPerThread = 16384;
+
+/* Decodes faces in two passes. The first pass is serial, validates face
+   sizes and finds where each thread should start reading and writing. The
+   second pass decodes and triangulates the faces in parallel, each thread
+   writing into its own slice of the pre-sized output. Each thread uses the
+   batch triangle conversion for its slice if the layout allows it, same as
+   the serial path. */
+bool extractFacesParallel(std::vector<UnsignedInt>& indices, const char*& position, const char* const end, const std::size_t faceCount, const std::size_t threadCount, const FileFormat fileFormat, const Type faceSizeType, const Type faceIndexType) {
+    struct Chunk {
+        const char* begin;
+        std::size_t faceCount;
+        std::size_t indexOffset;
+    };
+    std::vector<Chunk> chunks;
+    chunks.reserve(threadCount);
+
+    const std::size_t faceSizeTypeSize = stanfordTypeSize(faceSizeType);
+    const std::size_t faceIndexTypeSize = stanfordTypeSize(faceIndexType);
+    const std::size_t facesPerChunk = (faceCount + threadCount - 1)/threadCount;
+    std::size_t indexCount = indices.size();
+    for(std::size_t i = 0; i != faceCount; ++i) {
+        if(i % facesPerChunk == 0)
+            chunks.push_back({position, std::min(facesPerChunk, faceCount - i), indexCount});
+
+        if(std::size_t(end - position) < faceSizeTypeSize) {
+            Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+            return false;
+        }
+        const UnsignedInt faceSize = extractAndSkip<UnsignedInt>(position, fileFormat, faceSizeType);
+        if(faceSize < 3 || faceSize > 4) {
+            Error() << "Trade::StanfordImporter::mesh3D(): unsupported face size" << faceSize;
+            return false;
         }
+        if(std::size_t(end - position) < faceIndexTypeSize*faceSize) {
+            Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+            return false;
+        }
+
+        position += faceIndexTypeSize*faceSize;
+        indexCount += faceSize == 3 ? 3 : 6;
     }
 
-    /* Parse faces, reserve optimistically amount for all-triangle faces */
-    std::vector<UnsignedInt> indices;
+    indices.resize(indexCount);
+
+    const bool copy = canCopyTriangles(faceSizeTypeSize, faceIndexTypeSize);
+    auto decode = [&](const Chunk& chunk) {
+        const char* in = chunk.begin;
+        UnsignedInt* out = indices.data() + chunk.indexOffset;
+        std::size_t i = 0;
+        if(copy) {
+            i = faceIndexTypeSize == 4 ?
+                copyTriangles<UnsignedInt>(out, chunk.faceCount, in, end, fileFormat) :
+                copyTriangles<UnsignedShort>(out, chunk.faceCount, in, end, fileFormat);
+            out += i*3;
+        }
+        for(; i != chunk.faceCount; ++i) {
+            const UnsignedInt faceSize = extractAndSkip<UnsignedInt>(in, fileFormat, faceSizeType);
+            if(faceSize == 3) {
+                extractTriangle(out, in, fileFormat, faceIndexType);
+                out += 3;
+            } else {
+                extractQuad(out, in, fileFormat, faceIndexType);
+                out += 6;
+            }
+            in += faceIndexTypeSize*faceSize;
+        }
+    };
+
+    /* The calling thread processes the first chunk */
+    std::vector<std::thread> threads;
+    threads.reserve(chunks.size() - 1);
+    for(std::size_t i = 1; i < chunks.size(); ++i)
+        threads.emplace_back([&decode, &chunks, i]{ decode(chunks[i]); });
+    decode(chunks.front());
+    for(std::thread& thread: threads) thread.join();
+
+    return true;
+}
+#endif
+
+/* Whitespace separating values in ASCII files */
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+inline const char* skipWhitespace(const char* position, const char* const end) {
+    while(position != end && isWhitespace(*position)) ++position;
+    return position;
+}
+
+inline const char* skipToken(const char* position, const char* const end) {
+    position = skipWhitespace(position, end);
+    while(position != end && !isWhitespace(*position)) ++position;
+    return position;
+}
+
+inline bool isDigit(const char c) { return UnsignedByte(c - '0') < 10; }
+
+/* The ASCII number parsers below operate directly on the (mapped) file data
+   without copying each token to a std::string first. All of them skip
+   leading whitespace and return position after the number or nullptr if
+   there's no valid number. The number has to be followed by whitespace or
+   end of the data. */
+const char* parseUnsignedInt(const char* position, const char* const end, UnsignedInt& out) {
+    position = skipWhitespace(position, end);
+    if(position != end && *position == '+') ++position;
+
+    const char* const begin = position;
+    UnsignedLong value = 0;
+    for(; position != end && isDigit(*position); ++position) {
+        value = value*10 + (*position - '0');
+        if(value > 0xffffffffull) return nullptr;
+    }
+
+    if(position == begin || (position != end && !isWhitespace(*position)))
+        return nullptr;
+
+    out = UnsignedInt(value);
+    return position;
+}
+
+/* Powers of ten that are exactly representable in a double */
+constexpr Double PowersOfTen[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18,
+    1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/* Whether the token at given position is given lowercase word, ignoring
+   case */
+bool isWordIgnoringCase(const char* position, const char* const end, const char* word) {
+    for(; *word; ++position, ++word)
+        if(position == end || (*position | 0x20) != *word) return false;
+    return position == end || isWhitespace(*position);
+}
+
+/* Accumulates up to 18 significant digits into an integer mantissa, which is
+   then scaled by a single multiplication or division by a power of ten. That
+   is exact for all values that have a reasonable chance to appear in a PLY
+   file and then rounded to a float only once. Infinity and NaN are accepted
+   the same way as std::strtof() does, without the optional NaN payload. */
+const char* parseFloat(const char* position, const char* const end, Float& out) {
+    position = skipWhitespace(position, end);
+
+    bool negative = false;
+    if(position != end && (*position == '+' || *position == '-'))
+        negative = *position++ == '-';
+
+    if(isWordIgnoringCase(position, end, "nan")) {
+        out = negative ? -Constants::nan() : Constants::nan();
+        return position + 3;
+    }
+    if(isWordIgnoringCase(position, end, "inf")) {
+        out = negative ? -Constants::inf() : Constants::inf();
+        return position + 3;
+    }
+    if(isWordIgnoringCase(position, end, "infinity")) {
+        out = negative ? -Constants::inf() : Constants::inf();
+        return position + 8;
+    }
+
+    UnsignedLong mantissa = 0;
+    Int exponent = 0;
+    std::size_t digitCount = 0;
+    for(; position != end && isDigit(*position); ++position, ++digitCount) {
+        if(mantissa < 100000000000000000ull)
+            mantissa = mantissa*10 + (*position - '0');
+        else ++exponent;
+    }
+    if(position != end && *position == '.') {
+        ++position;
+        for(; position != end && isDigit(*position); ++position, ++digitCount) {
+            if(mantissa < 100000000000000000ull) {
+                mantissa = mantissa*10 + (*position - '0');
+                --exponent;
+            }
+        }
+    }
+    if(!digitCount) return nullptr;
+
+    if(position != end && (*position == 'e' || *position == 'E')) {
+        ++position;
+        bool negativeExponent = false;
+        if(position != end && (*position == '+' || *position == '-'))
+            negativeExponent = *position++ == '-';
+
+        const char* const exponentBegin = position;
+        Int value = 0;
+        for(; position != end && isDigit(*position); ++position)
+            if(value < 10000) value = value*10 + (*position - '0');
+        if(position == exponentBegin) return nullptr;
+
+        exponent += negativeExponent ? -value : value;
+    }
+
+    if(position != end && !isWhitespace(*position)) return nullptr;
+
+    /* Zero stays zero for any exponent, checking it here avoids 0*inf giving
+       a NaN below. Any non-zero mantissa scaled by more than this overflows
+       to infinity or underflows to zero even in a double, so the exponent is
+       clamped to save the std::pow() from huge values. */
+    if(!mantissa) {
+        out = negative ? -0.0f : 0.0f;
+        return position;
+    }
+    exponent = Math::clamp(exponent, -400, 400);
+
+    Double value = Double(mantissa);
+    if(exponent < 0)
+        value /= exponent >= -22 ? PowersOfTen[-exponent] : std::pow(10.0, -exponent);
+    else if(exponent > 0)
+        value *= exponent <= 22 ? PowersOfTen[exponent] : std::pow(10.0, exponent);
+
+    out = Float(negative ? -value : value);
+    return position;
+}
+
+/* Prints error for a value that failed to parse at given position */
+void printAsciiError(const char* position, const char* const end) {
+    position = skipWhitespace(position, end);
+    if(position == end)
+        Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+    else
+        Error() << "Trade::StanfordImporter::mesh3D(): invalid value" << std::string{position, skipToken(position, end)};
+}
+
+/* Skips given count of vertices, each having given count of properties */
+bool skipVerticesAscii(const char*& position, const char* const end, const std::size_t vertexCount, const std::size_t propertyCount) {
+    for(std::size_t i = 0, max = vertexCount*propertyCount; i != max; ++i) {
+        position = skipWhitespace(position, end);
+        if(position == end) {
+            Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+            return false;
+        }
+        position = skipToken(position, end);
+    }
+
+    return true;
+}
+
+/* Expects a target for each vertex property, including ignored ones */
+bool extractVerticesAscii(const std::vector<VertexTarget>& targets, const char*& position, const char* const end, const std::size_t vertexCount) {
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        for(const VertexTarget& target: targets) {
+            Float value{};
+            const char* const next = target.out ?
+                parseFloat(position, end, value) :
+                skipToken(position, end);
+            if(!next || skipWhitespace(position, end) == end) {
+                printAsciiError(position, end);
+                return false;
+            }
+            if(target.out)
+                target.out[i*target.stride + target.component] = value*target.scale;
+            position = next;
+        }
+    }
+
+    return true;
+}
+
+bool extractFacesAscii(std::vector<UnsignedInt>& indices, const char*& position, const char* const end, const std::size_t faceCount) {
+    /* Reserve optimistically amount for all-triangle faces */
     indices.reserve(faceCount*3);
+    for(std::size_t i = 0; i != faceCount; ++i) {
+        UnsignedInt faceSize;
+        const char* next = parseUnsignedInt(position, end, faceSize);
+        if(!next) {
+            printAsciiError(position, end);
+            return false;
+        }
+        position = next;
+        if(faceSize < 3 || faceSize > 4) {
+            Error() << "Trade::StanfordImporter::mesh3D(): unsupported face size" << faceSize;
+            return false;
+        }
+
+        UnsignedInt face[4];
+        for(UnsignedInt j = 0; j != faceSize; ++j) {
+            if(!(next = parseUnsignedInt(position, end, face[j]))) {
+                printAsciiError(position, end);
+                return false;
+            }
+            position = next;
+        }
+
+        /* Quads are triangulated the same way as in extractQuad() */
+        if(faceSize == 3)
+            indices.insert(indices.end(), {face[0], face[1], face[2]});
+        else
+            indices.insert(indices.end(), {face[0], face[1], face[2], face[0], face[2], face[3]});
+    }
+
+    return true;
+}
+
+void resizeAttributes(VertexAttributes& attributes, const Header& header, const std::size_t vertexCount) {
+    attributes.positions.resize(vertexCount);
+    if(header.hasNormals) attributes.normals.resize(vertexCount);
+    if(header.hasTextureCoordinates) attributes.textureCoordinates.resize(vertexCount);
+    if(header.hasColors) attributes.colors.resize(vertexCount);
+}
+
+/* Decodes vertices into attributes that are already sized for them and
+   advances the position past them */
+bool extractVertices(VertexAttributes& attributes, const Header& header, const char*& position, const char* const end) {
+    const std::size_t vertexCount = attributes.positions.size();
+    std::vector<VertexTarget> targets;
+    targets.reserve(header.vertexProperties.size());
+
+    /* ASCII files are tokenized in a single serial pass */
+    if(header.fileFormat == FileFormat::Ascii) {
+        for(const VertexProperty& property: header.vertexProperties)
+            targets.push_back(vertexTarget(attributes, property));
+
+        return extractVerticesAscii(targets, position, end, vertexCount);
+    }
+
+    const UnsignedInt stride = header.vertexStride;
+    if(std::size_t(end - position) < vertexCount*stride) {
+        Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+        return false;
+    }
+
+    /* Find out where the position components are */
+    Vector3i componentOffsets;
+    Array3D<Type> componentTypes;
+    for(const VertexProperty& property: header.vertexProperties) {
+        if(property.component < VertexComponent::PositionX || property.component > VertexComponent::PositionZ) continue;
+        const std::size_t component = UnsignedByte(property.component) - UnsignedByte(VertexComponent::PositionX);
+        componentOffsets[component] = property.offset;
+        componentTypes[component] = property.type;
+    }
+
+    /* If the positions are three consecutive components of the same type,
+       they can be converted in batches */
+    const std::size_t componentSize = stanfordTypeSize(componentTypes.x());
+    if(componentTypes.y() == componentTypes.x() &&
+       componentTypes.z() == componentTypes.x() &&
+       std::size_t(componentOffsets.y()) == componentOffsets.x() + componentSize &&
+       std::size_t(componentOffsets.z()) == componentOffsets.y() + componentSize)
     {
-        /* Assuming max four four-byte indices per face */
-        char buffer[4*4];
-
-        const UnsignedInt faceSizeTypeSize = sizeOf(faceSizeType);
-        const UnsignedInt faceIndexTypeSize = sizeOf(faceIndexType);
-        for(std::size_t i = 0; i != faceCount; ++i) {
-            /* Get face size */
-            _in->read(buffer, faceSizeTypeSize);
-            const UnsignedInt faceSize = extract<UnsignedInt>(buffer, fileFormat, faceSizeType);
-            if(faceSize < 3 || faceSize > 4) {
-                Error() << "Trade::StanfordImporter::mesh3D(): unsupported face size" << faceSize;
-                return Containers::NullOpt;
+        const Containers::ArrayView<Vector3> out{attributes.positions.data(), attributes.positions.size()};
+        switch(componentTypes.x()) {
+            #define _c(type) case Type::type: copyPositions<type>(out, position + componentOffsets.x(), stride, header.fileFormat); break;
+            _c(UnsignedByte)
+            _c(Byte)
+            _c(UnsignedShort)
+            _c(Short)
+            _c(UnsignedInt)
+            _c(Int)
+            _c(Float)
+            _c(Double)
+            #undef _c
+        }
+
+        /* All other attributes are extracted below */
+        for(const VertexProperty& property: header.vertexProperties)
+            if(property.component > VertexComponent::PositionZ)
+                targets.push_back(vertexTarget(attributes, property));
+
+    /* Otherwise extract and convert positions separately together with all
+       other attributes */
+    } else {
+        for(const VertexProperty& property: header.vertexProperties)
+            if(property.component != VertexComponent::Ignored)
+                targets.push_back(vertexTarget(attributes, property));
+    }
+
+    /* Decode remaining attributes in a single pass over the vertex data */
+    if(!targets.empty())
+        extractVertexProperties(targets, position, vertexCount, stride, header.fileFormat);
+
+    position += vertexCount*stride;
+    return true;
+}
+
+/* Hash for integer grid cells, from Teschner et al., Optimized Spatial
+   Hashing for Collision Detection of Deformable Objects */
+struct CellHash {
+    template<class T> std::size_t operator()(const Math::Vector3<T>& cell) const {
+        return std::size_t((UnsignedLong(cell.x())*73856093ull)^
+                           (UnsignedLong(cell.y())*19349663ull)^
+                           (UnsignedLong(cell.z())*83492791ull));
+    }
+};
+
+typedef Math::Vector3<Long> Cell;
+
+/* Grid cell containing given position. The quotient is clamped to 2^62 so
+   huge coordinates or tiny cell sizes can't overflow the conversion and the
+   neighboring cells can be still addressed. NaNs get a cell of their own
+   that's not a neighbor of any other. */
+Cell cellOf(const Vector3& position, const Float cellSize) {
+    constexpr Float Limit = 4611686018427387904.0f;
+    const Vector3 quotient = Math::floor(position/cellSize);
+    Cell out;
+    for(std::size_t i = 0; i != 3; ++i) {
+        if(quotient[i] != quotient[i]) out[i] = -Long(Limit) - 2;
+        else out[i] = Long(Math::clamp(quotient[i], -Limit, Limit));
+    }
+    return out;
+}
+
+/* Count of vertices decoded at once when downsampling or welding */
+constexpr std::size_t VertexChunkSize = 65536;
+
+/* Count of faces decoded at once when importing welded or compact indices */
+constexpr std::size_t FaceChunkSize = 16384;
+
+/* Decodes vertices in fixed-size chunks and keeps only the first vertex
+   falling into each cell of a voxel grid, so the memory use is proportional
+   to the output and not the input */
+bool extractVerticesDownsampled(VertexAttributes& out, const Header& header, const char*& position, const char* const end, const std::size_t vertexCount, const Float voxelSize) {
+    std::unordered_set<Cell, CellHash> cells;
+    VertexAttributes chunk;
+    for(std::size_t i = 0; i < vertexCount; i += VertexChunkSize) {
+        resizeAttributes(chunk, header, std::min(VertexChunkSize, vertexCount - i));
+        if(!extractVertices(chunk, header, position, end)) return false;
+
+        for(std::size_t j = 0; j != chunk.positions.size(); ++j) {
+            if(!cells.insert(cellOf(chunk.positions[j], voxelSize)).second)
+                continue;
+
+            out.positions.push_back(chunk.positions[j]);
+            if(header.hasNormals) out.normals.push_back(chunk.normals[j]);
+            if(header.hasTextureCoordinates) out.textureCoordinates.push_back(chunk.textureCoordinates[j]);
+            if(header.hasColors) out.colors.push_back(chunk.colors[j]);
+        }
+    }
+
+    return true;
+}
+
+/* Bit patterns of all attributes of a vertex, for exact welding. Attributes
+   not present in the file stay zero. */
+struct VertexBits {
+    UnsignedInt data[12];
+
+    bool operator==(const VertexBits& other) const {
+        return std::memcmp(data, other.data, sizeof(data)) == 0;
+    }
+};
+
+struct VertexBitsHash {
+    std::size_t operator()(const VertexBits& bits) const {
+        /* FNV-1a over the 32-bit words */
+        UnsignedInt hash = 2166136261u;
+        for(const UnsignedInt i: bits.data) hash = (hash ^ i)*16777619u;
+        return hash;
+    }
+};
+
+/* Adding zero turns -0.0 into 0.0 so they end up being the same */
+template<std::size_t size> void attributeBits(UnsignedInt* const out, const Math::Vector<size, Float>& value) {
+    for(std::size_t i = 0; i != size; ++i) {
+        const Float normalized = value[i] + 0.0f;
+        std::memcpy(out + i, &normalized, sizeof(Float));
+    }
+}
+
+VertexBits vertexBits(const VertexAttributes& attributes, const Header& header, const std::size_t i) {
+    VertexBits out{};
+    attributeBits(out.data, attributes.positions[i]);
+    if(header.hasNormals) attributeBits(out.data + 3, attributes.normals[i]);
+    if(header.hasTextureCoordinates) attributeBits(out.data + 6, attributes.textureCoordinates[i]);
+    if(header.hasColors) attributeBits(out.data + 8, attributes.colors[i]);
+    return out;
+}
+
+/* Whether all attributes of vertex b in the second array are closer than
+   given tolerance to vertex a in the first array */
+bool attributesClose(const VertexAttributes& a, const std::size_t aIndex, const VertexAttributes& b, const std::size_t bIndex, const Header& header, const Float toleranceSquared) {
+    return (a.positions[aIndex] - b.positions[bIndex]).dot() <= toleranceSquared &&
+        (!header.hasNormals || (a.normals[aIndex] - b.normals[bIndex]).dot() <= toleranceSquared) &&
+        (!header.hasTextureCoordinates || (a.textureCoordinates[aIndex] - b.textureCoordinates[bIndex]).dot() <= toleranceSquared) &&
+        (!header.hasColors || (a.colors[aIndex] - b.colors[bIndex]).dot() <= toleranceSquared);
+}
+
+/* Decodes vertices in fixed-size chunks and keeps only the first vertex of
+   each group that has all attributes closer than the tolerance to it. The
+   remap array is filled with the output vertex ID for each input vertex.
+   With zero tolerance only bit-exact vertices are merged, otherwise vertices
+   are put into a grid of cells of the tolerance size based on their position
+   and the neighboring cells are searched for close vertices. */
+bool extractVerticesWelded(VertexAttributes& out, std::vector<UnsignedInt>& remap, const Header& header, const char*& position, const char* const end, const std::size_t vertexCount, const Float tolerance) {
+    std::unordered_map<VertexBits, UnsignedInt, VertexBitsHash> exact;
+    std::unordered_multimap<Cell, UnsignedInt, CellHash> cells;
+    const Float toleranceSquared = tolerance*tolerance;
+    remap.reserve(vertexCount);
+    VertexAttributes chunk;
+    for(std::size_t i = 0; i < vertexCount; i += VertexChunkSize) {
+        resizeAttributes(chunk, header, std::min(VertexChunkSize, vertexCount - i));
+        if(!extractVertices(chunk, header, position, end)) return false;
+
+        for(std::size_t j = 0; j != chunk.positions.size(); ++j) {
+            const Vector3& vertex = chunk.positions[j];
+            const UnsignedInt id = out.positions.size();
+
+            /* Exact welding, a single lookup */
+            if(tolerance == 0.0f) {
+                const auto inserted = exact.emplace(vertexBits(chunk, header, j), id);
+                if(!inserted.second) {
+                    remap.push_back(inserted.first->second);
+                    continue;
+                }
+
+            /* Find a close enough vertex in the neighboring cells */
+            } else {
+                const Cell cell = cellOf(vertex, tolerance);
+                UnsignedInt found = ~UnsignedInt{};
+                for(Int z = -1; z <= 1 && found == ~UnsignedInt{}; ++z)
+                    for(Int y = -1; y <= 1 && found == ~UnsignedInt{}; ++y)
+                        for(Int x = -1; x <= 1 && found == ~UnsignedInt{}; ++x) {
+                            const auto range = cells.equal_range(cell + Cell{x, y, z});
+                            for(auto it = range.first; it != range.second; ++it) {
+                                if(attributesClose(out, it->second, chunk, j, header, toleranceSquared)) {
+                                    found = it->second;
+                                    break;
+                                }
+                            }
+                        }
+
+                if(found != ~UnsignedInt{}) {
+                    remap.push_back(found);
+                    continue;
+                }
+
+                cells.emplace(cell, id);
             }
 
-            /* Parse face indices */
-            if(!_in->read(buffer, faceIndexTypeSize*faceSize)) {
-                Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
-                return Containers::NullOpt;
+            remap.push_back(id);
+            out.positions.push_back(vertex);
+            if(header.hasNormals) out.normals.push_back(chunk.normals[j]);
+            if(header.hasTextureCoordinates) out.textureCoordinates.push_back(chunk.textureCoordinates[j]);
+            if(header.hasColors) out.colors.push_back(chunk.colors[j]);
+        }
+    }
+
+    return true;
+}
+
+/* Decodes faces into an empty index array and advances the position past
+   them. If the thread count is larger than 1, binary files can be decoded in
+   parallel. */
+bool extractFaces(std::vector<UnsignedInt>& indices, const Header& header, const char*& position, const char* const end, const std::size_t faceCount, std::size_t threadCount) {
+    if(header.fileFormat == FileFormat::Ascii)
+        return extractFacesAscii(indices, position, end, faceCount);
+
+    if(!faceCount) return true;
+
+    const FileFormat fileFormat = header.fileFormat;
+    const Type faceSizeType = header.faceSizeType;
+    const Type faceIndexType = header.faceIndexType;
+    const UnsignedInt faceSizeTypeSize = stanfordTypeSize(faceSizeType);
+    const UnsignedInt faceIndexTypeSize = stanfordTypeSize(faceIndexType);
+
+    /* If requested and there's enough faces, decode them in parallel */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    threadCount = std::min(threadCount, faceCount/MinFacesPerThread);
+    if(threadCount > 1)
+        return extractFacesParallel(indices, position, end, faceCount, threadCount, fileFormat, faceSizeType, faceIndexType);
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    /* Triangles are converted in batches if possible. The first face that
+       isn't a triangle (or is truncated) makes it fall back to the generic
+       path below. */
+    std::size_t i = 0;
+    if(canCopyTriangles(faceSizeTypeSize, faceIndexTypeSize)) {
+        indices.resize(faceCount*3);
+        i = faceIndexTypeSize == 4 ?
+            copyTriangles<UnsignedInt>(indices.data(), faceCount, position, end, fileFormat) :
+            copyTriangles<UnsignedShort>(indices.data(), faceCount, position, end, fileFormat);
+        indices.resize(i*3);
+    }
+
+    /* Reserve optimistically amount for all-triangle faces */
+    indices.reserve(faceCount*3);
+    for(; i != faceCount; ++i) {
+        /* Get face size */
+        if(std::size_t(end - position) < faceSizeTypeSize) {
+            Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+            return false;
+        }
+        const UnsignedInt faceSize = extractAndSkip<UnsignedInt>(position, fileFormat, faceSizeType);
+        if(faceSize < 3 || faceSize > 4) {
+            Error() << "Trade::StanfordImporter::mesh3D(): unsupported face size" << faceSize;
+            return false;
+        }
+
+        /* Parse face indices */
+        if(std::size_t(end - position) < faceIndexTypeSize*faceSize) {
+            Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+            return false;
+        }
+        const std::size_t offset = indices.size();
+        if(faceSize == 3) {
+            indices.resize(offset + 3);
+            extractTriangle(indices.data() + offset, position, fileFormat, faceIndexType);
+        } else {
+            indices.resize(offset + 6);
+            extractQuad(indices.data() + offset, position, fileFormat, faceIndexType);
+        }
+        position += faceIndexTypeSize*faceSize;
+    }
+
+    return true;
+}
+
+/* Decodes faces in fixed-size chunks and maps the indices through the remap
+   array while the chunk is still in cache, so there's no need for a separate
+   pass over the whole index array */
+bool extractFacesRemapped(std::vector<UnsignedInt>& indices, const std::vector<UnsignedInt>& remap, const Header& header, const char*& position, const char* const end, const std::size_t faceCount) {
+    indices.reserve(faceCount*3);
+    std::vector<UnsignedInt> chunk;
+    for(std::size_t i = 0; i < faceCount; i += FaceChunkSize) {
+        chunk.clear();
+        if(!extractFaces(chunk, header, position, end, std::min(FaceChunkSize, faceCount - i), 1))
+            return false;
+
+        for(const UnsignedInt index: chunk) {
+            if(index >= remap.size()) {
+                Error() << "Trade::StanfordImporter::mesh3D(): index" << index << "out of range for" << remap.size() << "vertices";
+                return false;
             }
-            faceSize == 3 ?
-                extractTriangle(indices, buffer, fileFormat, faceIndexType) :
-                extractQuad(indices, buffer, fileFormat, faceIndexType);
+
+            indices.push_back(remap[index]);
+        }
+    }
+
+    return true;
+}
+
+}
+
+Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(const UnsignedInt id) {
+    const Header& header = _state->header;
+    const FileFormat fileFormat = header.fileFormat;
+    const UnsignedInt faceCount = header.faceCount;
+    const char* position = _state->data.begin() + header.bodyOffset;
+    const char* const end = _state->data.end();
+
+    /* If importing a point cloud in batches, import just the requested range
+       of vertices */
+    std::size_t firstVertex = 0;
+    std::size_t vertexCount = header.vertexCount;
+    if(const std::size_t batchSize = pointCloudBatchSize(header, configuration())) {
+        firstVertex = std::min(std::size_t(id)*batchSize, vertexCount);
+        vertexCount = std::min(batchSize, vertexCount - firstVertex);
+    }
+
+    /* Vertex records in ASCII files have variable length, so skip the
+       batches before the requested one, continuing from the previous one if
+       possible */
+    if(fileFormat == FileFormat::Ascii) {
+        std::size_t skipVertexCount = firstVertex;
+        if(_state->asciiNextVertex && firstVertex >= _state->asciiNextVertex) {
+            position = _state->data.data() + _state->asciiNextVertexOffset;
+            skipVertexCount -= _state->asciiNextVertex;
+        }
+        if(!skipVerticesAscii(position, end, skipVertexCount, header.vertexProperties.size()))
+            return Containers::NullOpt;
+
+    /* Binary files can be indexed directly, too short files are caught when
+       extracting the vertices */
+    } else position += std::min(firstVertex*header.vertexStride, std::size_t(end - position));
+
+    /* Parse vertices, optionally downsampling point clouds */
+    VertexAttributes attributes;
+    const Float voxelSize = header.hasFaces ? 0.0f :
+        configuration().value<Float>("pointCloudVoxelSize");
+    const bool weld = header.hasFaces && configuration().value<bool>("weld");
+    const Float weldTolerance = weld ? configuration().value<Float>("weldTolerance") : 0.0f;
+    /* Negated so NaNs are caught as well */
+    if(!(voxelSize >= 0.0f && voxelSize < Constants::inf())) {
+        Error() << "Trade::StanfordImporter::mesh3D(): expected a non-negative finite pointCloudVoxelSize but got" << voxelSize;
+        return Containers::NullOpt;
+    }
+    if(!(weldTolerance >= 0.0f && weldTolerance < Constants::inf())) {
+        Error() << "Trade::StanfordImporter::mesh3D(): expected a non-negative finite weldTolerance but got" << weldTolerance;
+        return Containers::NullOpt;
+    }
+    std::vector<UnsignedInt> remap;
+    if(voxelSize > 0.0f) {
+        if(!extractVerticesDownsampled(attributes, header, position, end, vertexCount, voxelSize))
+            return Containers::NullOpt;
+    } else if(weld) {
+        if(!extractVerticesWelded(attributes, remap, header, position, end, vertexCount, weldTolerance))
+            return Containers::NullOpt;
+    } else {
+        resizeAttributes(attributes, header, vertexCount);
+        if(!extractVertices(attributes, header, position, end))
+            return Containers::NullOpt;
+    }
+
+    if(fileFormat == FileFormat::Ascii && !header.hasFaces) {
+        _state->asciiNextVertex = firstVertex + vertexCount;
+        _state->asciiNextVertexOffset = position - _state->data.data();
+    }
+
+    /* Parse faces */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::size_t threadCount = configuration().value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    #else
+    constexpr std::size_t threadCount = 1;
+    #endif
+    std::vector<UnsignedInt> indices;
+    if(weld) {
+        if(!extractFacesRemapped(indices, remap, header, position, end, faceCount))
+            return Containers::NullOpt;
+    } else if(!extractFaces(indices, header, position, end, faceCount, threadCount))
+        return Containers::NullOpt;
+
+    return meshData(std::move(indices), std::move(attributes), header);
+}
+
+namespace {
+
+template<class T> bool compactIndicesInto(char* const out, const std::vector<UnsignedInt>& indices, const std::size_t vertexCount) {
+    T* const compact = reinterpret_cast<T*>(out);
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        if(indices[i] >= vertexCount) {
+            Error() << "Trade::StanfordImporter::compactIndices(): index" << indices[i] << "out of range for" << vertexCount << "vertices";
+            return false;
         }
+
+        compact[i] = T(indices[i]);
+    }
+
+    return true;
+}
+
+}
+
+Containers::Optional<Containers::Array<char>> StanfordImporter::compactIndices(const UnsignedInt id, MeshIndexType& type) {
+    CORRADE_ASSERT(isOpened(), "Trade::StanfordImporter::compactIndices(): no file opened", {});
+    CORRADE_ASSERT(id < mesh3DCount(), "Trade::StanfordImporter::compactIndices(): index out of range", {});
+
+    const Header& header = _state->header;
+    const std::size_t vertexCount = header.vertexCount;
+    const std::size_t faceCount = header.faceCount;
+    if(vertexCount <= 256) type = MeshIndexType::UnsignedByte;
+    else if(vertexCount <= 65536) type = MeshIndexType::UnsignedShort;
+    else type = MeshIndexType::UnsignedInt;
+    const std::size_t typeSize = meshIndexTypeSize(type);
+
+    /* Point clouds have no indices */
+    if(!header.hasFaces) return Containers::Optional<Containers::Array<char>>{Containers::Array<char>{}};
+
+    /* Skip the vertex data */
+    const char* position = _state->data.begin() + header.bodyOffset;
+    const char* const end = _state->data.end();
+    if(header.fileFormat == FileFormat::Ascii) {
+        if(!skipVerticesAscii(position, end, vertexCount, header.vertexProperties.size()))
+            return Containers::NullOpt;
+    } else {
+        if(std::size_t(end - position) < vertexCount*header.vertexStride) {
+            Error() << "Trade::StanfordImporter::compactIndices(): file is too short";
+            return Containers::NullOpt;
+        }
+        position += vertexCount*header.vertexStride;
+    }
+
+    /* Allocate optimistically for all-triangle faces, grow if there are
+       quads */
+    Containers::Array<char> out{Containers::NoInit, faceCount*3*typeSize};
+    std::size_t outSize = 0;
+    std::vector<UnsignedInt> chunk;
+    for(std::size_t i = 0; i < faceCount; i += FaceChunkSize) {
+        chunk.clear();
+        if(!extractFaces(chunk, header, position, end, std::min(FaceChunkSize, faceCount - i), 1))
+            return Containers::NullOpt;
+
+        const std::size_t chunkSize = chunk.size()*typeSize;
+        if(out.size() < outSize + chunkSize) {
+            Containers::Array<char> grown{Containers::NoInit, std::max(outSize + chunkSize, out.size()*2)};
+            std::copy(out.begin(), out.begin() + outSize, grown.begin());
+            out = std::move(grown);
+        }
+
+        bool compacted{};
+        switch(type) {
+            #define _c(type) case MeshIndexType::type: compacted = compactIndicesInto<type>(out + outSize, chunk, vertexCount); break;
+            _c(UnsignedByte)
+            _c(UnsignedShort)
+            _c(UnsignedInt)
+            #undef _c
+        }
+        if(!compacted) return Containers::NullOpt;
+
+        outSize += chunkSize;
+    }
+
+    /* Shrink to the actual size if the growing overshot */
+    if(outSize != out.size()) {
+        Containers::Array<char> shrunk{Containers::NoInit, outSize};
+        std::copy(out.begin(), out.begin() + outSize, shrunk.begin());
+        out = std::move(shrunk);
     }
 
-    return MeshData3D{MeshPrimitive::Triangles, std::move(indices), {std::move(positions)}, {}, {}, {}, nullptr};
+    return Containers::Optional<Containers::Array<char>>{std::move(out)};
 }
 
 }}
@@ -30,6 +30,8 @@
  */
 
 #include <memory>
+#include <Corrade/Containers/Array.h>
+#include <Magnum/Mesh.h>
 #include <Magnum/Trade/AbstractImporter.h>
 
 #include "MagnumPlugins/StanfordImporter/configure.h"
@@ -55,8 +57,36 @@ namespace Magnum { namespace Trade {
 /**
 @brief Stanford PLY importer plugin
 
-Supports little and big endian binary format (ASCII files are not supported),
-triangle/quad meshes. Only vertex positions are imported.
+Supports little and big endian binary format and ASCII format, triangle/quad
+meshes. Vertex positions (`x`, `y`, `z`), normals (`nx`, `ny`, `nz`), texture
+coordinates (`u`, `v`, `s`, `t`, `texture_u`, `texture_v`, `texture_s`,
+`texture_t`) and colors (`red`, `green`, `blue`, `alpha`) are imported, other
+vertex properties are ignored. Colors stored as integers are normalized to
+the @f$ [0, 1] @f$ range, alpha is set to @cpp 1.0f @ce if not present. All
+attributes are decoded in a single pass over the vertex data.
+
+Files without a face element are imported as point clouds with
+@ref MeshPrimitive::Points. Large point clouds can be imported in batches of
+bounded size by setting the @cb{.ini} pointCloudBatchSize @ce
+@ref Trade-StanfordImporter-configuration "configuration option", each batch
+is then a separate mesh. Batches of binary files can be imported in any
+order at a constant cost, ASCII files are fastest to import in order.
+Point clouds can be also downsampled on a voxel grid during import using the
+@cb{.ini} pointCloudVoxelSize @ce option.
+
+Meshes with duplicated vertices can be welded during import by enabling the
+@cb{.ini} weld @ce option. Vertices having all imported attributes closer
+than @cb{.ini} weldTolerance @ce are found using a hash grid as the vertex
+data are decoded and the indices are remapped while decoding the faces.
+
+Files opened through @ref openFile() are memory-mapped on platforms that
+support it and the vertex and face data are decoded directly from the mapped
+memory. Data passed to @ref openData() are copied once, as there's no
+guarantee they stay in scope after the function returns. ASCII files are
+tokenized in place, without creating temporary strings for the values; they
+are always decoded on a single thread.
+
+Meshes can be written back to PLY files using @ref StanfordSceneConverter.
 
 This plugin depends on the @ref Trade library and is built if
 `WITH_STANFORDIMPORTER` is enabled when building Magnum Plugins. To use as a
@@ -66,6 +96,20 @@ another plugin with CMake, you need to request the `StanfordImporter` component
 of the `MagnumPlugins` package and link to the
 `MagnumPlugins::StanfordImporter` target. See @ref building-plugins,
 @ref cmake-plugins and @ref plugins for more information.
+
+@section Trade-StanfordImporter-api Plugin-specific API
+
+Besides the @ref AbstractImporter interface, the plugin provides
+@ref compactIndices(). It's virtual in order to be callable also on a
+dynamically loaded plugin instance, without linking to it --- just cast the
+@ref AbstractImporter pointer to @ref StanfordImporter.
+
+@section Trade-StanfordImporter-configuration Plugin-specific config
+
+It's possible to tune various import options through @ref configuration().
+See below for all options and their default values.
+
+@snippet MagnumPlugins/StanfordImporter/StanfordImporter.conf config
 */
 class MAGNUM_STANFORDIMPORTER_EXPORT StanfordImporter: public AbstractImporter {
     public:
@@ -77,7 +121,32 @@ class MAGNUM_STANFORDIMPORTER_EXPORT StanfordImporter: public AbstractImporter {
 
         ~StanfordImporter();
 
+        /**
+         * @brief Import mesh indices in the narrowest sufficient type
+         * @param[in]  id    Mesh ID, from range [0, @ref mesh3DCount())
+         * @param[out] type  Index type
+         *
+         * While @ref mesh3D() always widens the indices to
+         * @ref Magnum::UnsignedInt "UnsignedInt", this function imports
+         * just the indices and stores them as
+         * @ref MeshIndexType::UnsignedByte if the file has at most 256
+         * vertices, @ref MeshIndexType::UnsignedShort if it has at most
+         * 65536 vertices and @ref MeshIndexType::UnsignedInt otherwise. Faces
+         * are decoded in chunks, so there's no temporary full-size 32-bit
+         * index array. Vertex data are not decoded. Indices out of range
+         * for the vertex count are reported as an error. The indices
+         * always refer to vertices as stored in the file, the
+         * @cb{.ini} weld @ce option is not taken into account.
+         *
+         * Returns an empty array for point clouds and
+         * @ref Containers::NullOpt on failure. Expects that a file is
+         * opened.
+         */
+        virtual Containers::Optional<Containers::Array<char>> compactIndices(UnsignedInt id, MeshIndexType& type);
+
     private:
+        struct State;
+
         MAGNUM_STANFORDIMPORTER_LOCAL Features doFeatures() const override;
 
         MAGNUM_STANFORDIMPORTER_LOCAL bool doIsOpened() const override;
@@ -88,7 +157,7 @@ class MAGNUM_STANFORDIMPORTER_EXPORT StanfordImporter: public AbstractImporter {
         MAGNUM_STANFORDIMPORTER_LOCAL UnsignedInt doMesh3DCount() const override;
         MAGNUM_STANFORDIMPORTER_LOCAL Containers::Optional<MeshData3D> doMesh3D(UnsignedInt id) override;
 
-        std::unique_ptr<std::istream> _in;
+        std::unique_ptr<State> _state;
 };
 
 }}
@@ -0,0 +1,418 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StanfordSceneConverter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Packing.h>
+#include <Magnum/Trade/MeshData3D.h>
+
+#include "MagnumPlugins/StanfordImporter/StanfordType.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+using Implementation::StanfordType;
+using Implementation::stanfordTypeName;
+using Implementation::stanfordTypeSize;
+
+typedef StanfordSceneConverter::Attribute Attribute;
+typedef StanfordSceneConverter::Attributes Attributes;
+
+/* Streamed data are collected in a block of this size before being written
+   to the file */
+constexpr std::size_t BlockSize = 1024*1024;
+
+/* Faces are always triangles, so the size fits into a byte */
+constexpr StanfordType FaceSizeType = StanfordType::UnsignedByte;
+constexpr StanfordType FaceIndexType = StanfordType::UnsignedInt;
+
+std::size_t vertexSize(const Attributes attributes) {
+    std::size_t size = 3*stanfordTypeSize(StanfordType::Float);
+    if(attributes & Attribute::Normals)
+        size += 3*stanfordTypeSize(StanfordType::Float);
+    if(attributes & Attribute::TextureCoordinates)
+        size += 2*stanfordTypeSize(StanfordType::Float);
+    if(attributes & Attribute::Colors)
+        size += 4*stanfordTypeSize(StanfordType::UnsignedByte);
+    return size;
+}
+
+std::size_t faceSize() {
+    return stanfordTypeSize(FaceSizeType) + 3*stanfordTypeSize(FaceIndexType);
+}
+
+std::string fileHeader(const Attributes attributes, const UnsignedInt vertexCount, const UnsignedInt faceCount) {
+    std::string out = "ply\nformat binary_little_endian 1.0\n";
+
+    const auto property = [&out](const StanfordType type, const char* name) {
+        out += "property ";
+        out += stanfordTypeName(type);
+        out += ' ';
+        out += name;
+        out += '\n';
+    };
+
+    out += "element vertex " + std::to_string(vertexCount) + '\n';
+    for(const char* name: {"x", "y", "z"})
+        property(StanfordType::Float, name);
+    if(attributes & Attribute::Normals) for(const char* name: {"nx", "ny", "nz"})
+        property(StanfordType::Float, name);
+    if(attributes & Attribute::TextureCoordinates) for(const char* name: {"u", "v"})
+        property(StanfordType::Float, name);
+    if(attributes & Attribute::Colors) for(const char* name: {"red", "green", "blue", "alpha"})
+        property(StanfordType::UnsignedByte, name);
+
+    /* Point clouds have no face element */
+    if(faceCount) {
+        out += "element face " + std::to_string(faceCount) + '\n';
+        out += "property list ";
+        out += stanfordTypeName(FaceSizeType);
+        out += ' ';
+        out += stanfordTypeName(FaceIndexType);
+        out += " vertex_indices\n";
+    }
+
+    out += "end_header\n";
+    return out;
+}
+
+template<class T> inline void write(char*& out, T value) {
+    value = Utility::Endianness::littleEndian(value);
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+/* Writes vertices in range [begin, end) to out, which has to be large enough.
+   The attribute views have to be either empty or have the same size as
+   positions, depending on attributes. */
+char* writeVertices(char* out, const Attributes attributes, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, const Containers::ArrayView<const Vector2> textureCoordinates, const Containers::ArrayView<const Color4> colors, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
+        for(std::size_t j = 0; j != 3; ++j)
+            write(out, positions[i][j]);
+        if(attributes & Attribute::Normals) for(std::size_t j = 0; j != 3; ++j)
+            write(out, normals[i][j]);
+        if(attributes & Attribute::TextureCoordinates) for(std::size_t j = 0; j != 2; ++j)
+            write(out, textureCoordinates[i][j]);
+        if(attributes & Attribute::Colors) for(std::size_t j = 0; j != 4; ++j)
+            write(out, Math::pack<UnsignedByte>(Math::clamp(colors[i][j], 0.0f, 1.0f)));
+    }
+
+    return out;
+}
+
+/* Writes faces in range [begin, end) to out, which has to be large enough */
+char* writeFaces(char* out, const Containers::ArrayView<const UnsignedInt> indices, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
+        write(out, UnsignedByte(3));
+        write(out, indices[i*3 + 0]);
+        write(out, indices[i*3 + 1]);
+        write(out, indices[i*3 + 2]);
+    }
+
+    return out;
+}
+
+/* Data of a mesh to write, validated */
+struct MeshView {
+    Attributes attributes;
+    Containers::ArrayView<const Vector3> positions, normals;
+    Containers::ArrayView<const Vector2> textureCoordinates;
+    Containers::ArrayView<const Color4> colors;
+    Containers::ArrayView<const UnsignedInt> indices;
+};
+
+bool meshView(const MeshData3D& mesh, const char* const messagePrefix, MeshView& out) {
+    if(mesh.primitive() != MeshPrimitive::Triangles && mesh.primitive() != MeshPrimitive::Points) {
+        Error() << messagePrefix << "unsupported primitive" << mesh.primitive();
+        return false;
+    }
+
+    if(!mesh.positionArrayCount()) {
+        Error() << messagePrefix << "the mesh has no positions";
+        return false;
+    }
+
+    const std::vector<Vector3>& positions = mesh.positions(0);
+    out.positions = Containers::arrayView(positions.data(), positions.size());
+
+    if(mesh.normalArrayCount()) {
+        const std::vector<Vector3>& normals = mesh.normals(0);
+        if(normals.size() != positions.size()) {
+            Error() << messagePrefix << "expected" << positions.size() << "normals but got" << normals.size();
+            return false;
+        }
+        out.attributes |= Attribute::Normals;
+        out.normals = Containers::arrayView(normals.data(), normals.size());
+    }
+
+    if(mesh.textureCoords2DArrayCount()) {
+        const std::vector<Vector2>& textureCoordinates = mesh.textureCoords2D(0);
+        if(textureCoordinates.size() != positions.size()) {
+            Error() << messagePrefix << "expected" << positions.size() << "texture coordinates but got" << textureCoordinates.size();
+            return false;
+        }
+        out.attributes |= Attribute::TextureCoordinates;
+        out.textureCoordinates = Containers::arrayView(textureCoordinates.data(), textureCoordinates.size());
+    }
+
+    if(mesh.colorArrayCount()) {
+        const std::vector<Color4>& colors = mesh.colors(0);
+        if(colors.size() != positions.size()) {
+            Error() << messagePrefix << "expected" << positions.size() << "colors but got" << colors.size();
+            return false;
+        }
+        out.attributes |= Attribute::Colors;
+        out.colors = Containers::arrayView(colors.data(), colors.size());
+    }
+
+    /* Point clouds are written without faces */
+    if(mesh.primitive() == MeshPrimitive::Triangles) {
+        if(!mesh.isIndexed()) {
+            Error() << messagePrefix << "non-indexed meshes are not supported";
+            return false;
+        }
+
+        const std::vector<UnsignedInt>& indices = mesh.indices();
+        if(indices.size() % 3) {
+            Error() << messagePrefix << "index count" << indices.size() << "is not divisible by three";
+            return false;
+        }
+        out.indices = Containers::arrayView(indices.data(), indices.size());
+    }
+
+    return true;
+}
+
+}
+
+struct StanfordSceneConverter::State {
+    bool flush(const char* messagePrefix);
+
+    std::ofstream file;
+    std::string filename;
+    Attributes attributes;
+    UnsignedInt vertexCount, faceCount;
+    UnsignedInt writtenVertexCount{}, writtenFaceCount{};
+
+    Containers::Array<char> block{BlockSize};
+    std::size_t blockFilled{};
+};
+
+bool StanfordSceneConverter::State::flush(const char* const messagePrefix) {
+    file.write(block, blockFilled);
+    blockFilled = 0;
+    if(!file) {
+        Error() << messagePrefix << "can't write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
+StanfordSceneConverter::StanfordSceneConverter() = default;
+
+StanfordSceneConverter::~StanfordSceneConverter() = default;
+
+Containers::Optional<Containers::Array<char>> StanfordSceneConverter::convertToData(const MeshData3D& mesh) {
+    MeshView view;
+    if(!meshView(mesh, "Trade::StanfordSceneConverter::convertToData():", view))
+        return Containers::NullOpt;
+
+    /* The size is known upfront, write everything directly to the output */
+    const std::size_t vertexCount = view.positions.size();
+    const std::size_t faceCount = view.indices.size()/3;
+    const std::string header = fileHeader(view.attributes, vertexCount, faceCount);
+    Containers::Array<char> out{header.size() + vertexCount*vertexSize(view.attributes) + faceCount*faceSize()};
+
+    std::memcpy(out, header.data(), header.size());
+    char* position = writeVertices(out + header.size(), view.attributes, view.positions, view.normals, view.textureCoordinates, view.colors, 0, vertexCount);
+    position = writeFaces(position, view.indices, 0, faceCount);
+    CORRADE_INTERNAL_ASSERT(position == out.end());
+
+    return Containers::Optional<Containers::Array<char>>{std::move(out)};
+}
+
+bool StanfordSceneConverter::convertToFile(const std::string& filename, const MeshData3D& mesh) {
+    MeshView view;
+    if(!meshView(mesh, "Trade::StanfordSceneConverter::convertToFile():", view))
+        return false;
+
+    return beginFile(filename, view.attributes, view.positions.size(), view.indices.size()/3) &&
+        addVertices(view.positions, view.normals, view.textureCoordinates, view.colors) &&
+        addFaces(view.indices) &&
+        endFile();
+}
+
+bool StanfordSceneConverter::beginFile(const std::string& filename, const Attributes attributes, const UnsignedInt vertexCount, const UnsignedInt faceCount) {
+    CORRADE_ASSERT(!_state, "Trade::StanfordSceneConverter::beginFile(): a file is already being streamed", false);
+
+    std::unique_ptr<State> state{new State};
+    state->file.open(filename, std::ofstream::binary);
+    if(!state->file) {
+        Error() << "Trade::StanfordSceneConverter::beginFile(): can't open file" << filename;
+        return false;
+    }
+
+    state->filename = filename;
+    state->attributes = attributes;
+    state->vertexCount = vertexCount;
+    state->faceCount = faceCount;
+
+    const std::string header = fileHeader(attributes, vertexCount, faceCount);
+    state->file.write(header.data(), header.size());
+    if(!state->file) {
+        Error() << "Trade::StanfordSceneConverter::beginFile(): can't write to file" << filename;
+        return false;
+    }
+
+    _state = std::move(state);
+    return true;
+}
+
+bool StanfordSceneConverter::isStreaming() const { return !!_state; }
+
+bool StanfordSceneConverter::addVertices(const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, const Containers::ArrayView<const Vector2> textureCoordinates, const Containers::ArrayView<const Color4> colors) {
+    CORRADE_ASSERT(_state, "Trade::StanfordSceneConverter::addVertices(): no file is being streamed", false);
+
+    const Attributes attributes = _state->attributes;
+    const std::size_t count = positions.size();
+    if(_state->writtenFaceCount) {
+        Error() << "Trade::StanfordSceneConverter::addVertices(): vertices have to be added before faces";
+        _state = nullptr;
+        return false;
+    }
+    if(_state->writtenVertexCount + count > _state->vertexCount) {
+        Error() << "Trade::StanfordSceneConverter::addVertices(): expected only" << _state->vertexCount << "vertices but got" << _state->writtenVertexCount + count;
+        _state = nullptr;
+        return false;
+    }
+    if(normals.size() != (attributes & Attribute::Normals ? count : 0)) {
+        Error() << "Trade::StanfordSceneConverter::addVertices(): expected" << (attributes & Attribute::Normals ? count : 0) << "normals but got" << normals.size();
+        _state = nullptr;
+        return false;
+    }
+    if(textureCoordinates.size() != (attributes & Attribute::TextureCoordinates ? count : 0)) {
+        Error() << "Trade::StanfordSceneConverter::addVertices(): expected" << (attributes & Attribute::TextureCoordinates ? count : 0) << "texture coordinates but got" << textureCoordinates.size();
+        _state = nullptr;
+        return false;
+    }
+    if(colors.size() != (attributes & Attribute::Colors ? count : 0)) {
+        Error() << "Trade::StanfordSceneConverter::addVertices(): expected" << (attributes & Attribute::Colors ? count : 0) << "colors but got" << colors.size();
+        _state = nullptr;
+        return false;
+    }
+
+    /* Fill the block with as many vertices as fit, flush it when full */
+    const std::size_t size = vertexSize(attributes);
+    for(std::size_t i = 0; i != count; ) {
+        const std::size_t end = i + std::min(count - i, (BlockSize - _state->blockFilled)/size);
+        if(end == i) {
+            if(!_state->flush("Trade::StanfordSceneConverter::addVertices():")) {
+                _state = nullptr;
+                return false;
+            }
+            continue;
+        }
+
+        writeVertices(_state->block + _state->blockFilled, attributes, positions, normals, textureCoordinates, colors, i, end);
+        _state->blockFilled += (end - i)*size;
+        i = end;
+    }
+
+    _state->writtenVertexCount += count;
+    return true;
+}
+
+bool StanfordSceneConverter::addFaces(const Containers::ArrayView<const UnsignedInt> indices) {
+    CORRADE_ASSERT(_state, "Trade::StanfordSceneConverter::addFaces(): no file is being streamed", false);
+
+    if(indices.size() % 3) {
+        Error() << "Trade::StanfordSceneConverter::addFaces(): index count" << indices.size() << "is not divisible by three";
+        _state = nullptr;
+        return false;
+    }
+
+    const std::size_t count = indices.size()/3;
+    if(_state->writtenFaceCount + count > _state->faceCount) {
+        Error() << "Trade::StanfordSceneConverter::addFaces(): expected only" << _state->faceCount << "faces but got" << _state->writtenFaceCount + count;
+        _state = nullptr;
+        return false;
+    }
+
+    /* Vertices have to be all written before the faces */
+    if(count && _state->writtenVertexCount != _state->vertexCount) {
+        Error() << "Trade::StanfordSceneConverter::addFaces(): expected" << _state->vertexCount << "vertices before faces but got" << _state->writtenVertexCount;
+        _state = nullptr;
+        return false;
+    }
+
+    const std::size_t size = faceSize();
+    for(std::size_t i = 0; i != count; ) {
+        const std::size_t end = i + std::min(count - i, (BlockSize - _state->blockFilled)/size);
+        if(end == i) {
+            if(!_state->flush("Trade::StanfordSceneConverter::addFaces():")) {
+                _state = nullptr;
+                return false;
+            }
+            continue;
+        }
+
+        writeFaces(_state->block + _state->blockFilled, indices, i, end);
+        _state->blockFilled += (end - i)*size;
+        i = end;
+    }
+
+    _state->writtenFaceCount += count;
+    return true;
+}
+
+bool StanfordSceneConverter::endFile() {
+    CORRADE_ASSERT(_state, "Trade::StanfordSceneConverter::endFile(): no file is being streamed", false);
+
+    std::unique_ptr<State> state = std::move(_state);
+    if(state->writtenVertexCount != state->vertexCount || state->writtenFaceCount != state->faceCount) {
+        Error() << "Trade::StanfordSceneConverter::endFile(): expected" << state->vertexCount << "vertices and" << state->faceCount << "faces but got" << state->writtenVertexCount << "and" << state->writtenFaceCount;
+        return false;
+    }
+
+    if(!state->flush("Trade::StanfordSceneConverter::endFile():"))
+        return false;
+
+    state->file.close();
+    return true;
+}
+
+}}
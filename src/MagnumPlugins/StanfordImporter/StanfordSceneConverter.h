@@ -0,0 +1,207 @@
+#ifndef Magnum_Trade_StanfordSceneConverter_h
+#define Magnum_Trade_StanfordSceneConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::StanfordSceneConverter
+ */
+
+#include <memory>
+#include <string>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Trade/Trade.h>
+
+#include "MagnumPlugins/StanfordImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_STANFORDSCENECONVERTER_BUILD_STATIC
+    #ifdef MagnumStanfordSceneConverter_EXPORTS
+        #define MAGNUM_STANFORDSCENECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_STANFORDSCENECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_STANFORDSCENECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_STANFORDSCENECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_STANFORDSCENECONVERTER_EXPORT
+#define MAGNUM_STANFORDSCENECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Stanford PLY writer
+
+Writes binary little-endian PLY files that can be imported back with
+@ref StanfordImporter. Vertex positions (`x`, `y`, `z`), normals (`nx`, `ny`,
+`nz`) and texture coordinates (`u`, `v`) are written as floats, colors
+(`red`, `green`, `blue`, `alpha`) as normalized unsigned bytes. Triangle
+indices are written as an unsigned byte size and unsigned int indices.
+Meshes with @ref MeshPrimitive::Points are written without a face element,
+primitives other than @ref MeshPrimitive::Triangles are not supported.
+
+The whole file can be produced at once using @ref convertToData() or
+@ref convertToFile(), the latter writes the data through a fixed-size block
+buffer, never having the whole output in memory. For meshes that don't fit
+into memory either, the file can be written in a streaming fashion: call
+@ref beginFile() with the final vertex and face count, then
+@ref addVertices() and @ref addFaces() as many times as needed and finally
+@ref endFile(), which verifies that the announced counts were written.
+
+This class depends on the @ref Trade library and is built as a separate
+`MagnumStanfordSceneConverter` library if `WITH_STANFORDIMPORTER` is enabled
+when building Magnum Plugins, so it's available regardless of whether the
+plugin itself is built as static or dynamic. To use it with CMake, you need
+to request the `StanfordSceneConverter` component of the `MagnumPlugins`
+package and link to the `MagnumPlugins::StanfordSceneConverter` target. See
+@ref building-plugins and @ref cmake-plugins for more information.
+*/
+class MAGNUM_STANFORDSCENECONVERTER_EXPORT StanfordSceneConverter {
+    public:
+        /**
+         * @brief Vertex attribute
+         *
+         * Positions are always written.
+         * @see @ref Attributes, @ref beginFile()
+         */
+        enum class Attribute: UnsignedByte {
+            Normals = 1 << 0,               /**< Normals */
+            TextureCoordinates = 1 << 1,    /**< Texture coordinates */
+            Colors = 1 << 2                 /**< Colors */
+        };
+
+        /**
+         * @brief Vertex attributes
+         *
+         * @see @ref beginFile()
+         */
+        typedef Containers::EnumSet<Attribute> Attributes;
+
+        /** @brief Constructor */
+        explicit StanfordSceneConverter();
+
+        /** @brief Copying is not allowed */
+        StanfordSceneConverter(const StanfordSceneConverter&) = delete;
+
+        /** @brief Moving is not allowed */
+        StanfordSceneConverter(StanfordSceneConverter&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * If a file is being streamed, it's closed without checking that all
+         * announced data were written.
+         */
+        ~StanfordSceneConverter();
+
+        /** @brief Copying is not allowed */
+        StanfordSceneConverter& operator=(const StanfordSceneConverter&) = delete;
+
+        /** @brief Moving is not allowed */
+        StanfordSceneConverter& operator=(StanfordSceneConverter&&) = delete;
+
+        /**
+         * @brief Convert a mesh to a PLY file data
+         *
+         * Writes the first position, normal, texture coordinate and color
+         * array of the mesh. On failure prints a message to
+         * @ref Error and returns @ref Containers::NullOpt.
+         */
+        Containers::Optional<Containers::Array<char>> convertToData(const MeshData3D& mesh);
+
+        /**
+         * @brief Convert a mesh to a PLY file
+         *
+         * Like @ref convertToData(), but writes directly to a file in
+         * blocks of bounded size. Expects that there is no file being
+         * streamed.
+         */
+        bool convertToFile(const std::string& filename, const MeshData3D& mesh);
+
+        /**
+         * @brief Begin streaming a file
+         * @param filename      Output file
+         * @param attributes    Vertex attributes written in addition to
+         *      positions
+         * @param vertexCount   Total vertex count
+         * @param faceCount     Total triangle count. If @cpp 0 @ce, the
+         *      file is written as a point cloud without a face element.
+         *
+         * Writes the file header. On failure prints a message to
+         * @ref Error and returns @cpp false @ce. Expects that there is no
+         * file being streamed already.
+         */
+        bool beginFile(const std::string& filename, Attributes attributes, UnsignedInt vertexCount, UnsignedInt faceCount);
+
+        /** @brief Whether a file is being streamed */
+        bool isStreaming() const;
+
+        /**
+         * @brief Add vertices to a streamed file
+         *
+         * The @p normals, @p textureCoordinates and @p colors have to be
+         * specified if and only if they were requested in @ref beginFile()
+         * and have the same size as @p positions. All vertices have to be
+         * added before any faces. On failure prints a message to
+         * @ref Error, closes the file and returns @cpp false @ce.
+         */
+        bool addVertices(Containers::ArrayView<const Vector3> positions, Containers::ArrayView<const Vector3> normals = nullptr, Containers::ArrayView<const Vector2> textureCoordinates = nullptr, Containers::ArrayView<const Color4> colors = nullptr);
+
+        /**
+         * @brief Add faces to a streamed file
+         *
+         * The @p indices are triangles, their count has to be divisible by
+         * three. On failure prints a message to @ref Error, closes the file
+         * and returns @cpp false @ce.
+         */
+        bool addFaces(Containers::ArrayView<const UnsignedInt> indices);
+
+        /**
+         * @brief End a streamed file
+         *
+         * Flushes remaining data and closes the file. If fewer vertices or
+         * faces than announced in @ref beginFile() were written, prints a
+         * message to @ref Error and returns @cpp false @ce.
+         */
+        bool endFile();
+
+    private:
+        struct State;
+
+        std::unique_ptr<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(StanfordSceneConverter::Attributes)
+
+}}
+
+#endif
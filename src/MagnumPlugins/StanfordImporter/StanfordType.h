@@ -0,0 +1,94 @@
+#ifndef Magnum_Trade_Implementation_StanfordType_h
+#define Magnum_Trade_Implementation_StanfordType_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Magnum.h>
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* Property types, shared between StanfordImporter and StanfordSceneConverter */
+enum class StanfordType {
+    UnsignedByte = 1,
+    Byte,
+    UnsignedShort,
+    Short,
+    UnsignedInt,
+    Int,
+    Float,
+    Double
+};
+
+inline StanfordType parseStanfordType(const std::string& type) {
+    if(type == "uchar"  || type == "uint8")     return StanfordType::UnsignedByte;
+    if(type == "char"   || type == "int8")      return StanfordType::Byte;
+    if(type == "ushort" || type == "uint16")    return StanfordType::UnsignedShort;
+    if(type == "short"  || type == "int16")     return StanfordType::Short;
+    if(type == "uint"   || type == "uint32")    return StanfordType::UnsignedInt;
+    if(type == "int"    || type == "int32")     return StanfordType::Int;
+    if(type == "float"  || type == "float32")   return StanfordType::Float;
+    if(type == "double" || type == "float64")   return StanfordType::Double;
+
+    return {};
+}
+
+/* Name used when writing the type to a file header */
+inline const char* stanfordTypeName(const StanfordType type) {
+    switch(type) {
+        case StanfordType::UnsignedByte:    return "uchar";
+        case StanfordType::Byte:            return "char";
+        case StanfordType::UnsignedShort:   return "ushort";
+        case StanfordType::Short:           return "short";
+        case StanfordType::UnsignedInt:     return "uint";
+        case StanfordType::Int:             return "int";
+        case StanfordType::Float:           return "float";
+        case StanfordType::Double:          return "double";
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+inline std::size_t stanfordTypeSize(const StanfordType type) {
+    switch(type) {
+        #define _c(type) case StanfordType::type: return sizeof(type);
+        _c(UnsignedByte)
+        _c(Byte)
+        _c(UnsignedShort)
+        _c(Short)
+        _c(UnsignedInt)
+        _c(Int)
+        _c(Float)
+        _c(Double)
+        #undef _c
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}}}
+
+#endif
@@ -0,0 +1,558 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/Math/Vector3.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/MeshData3D.h>
+
+#include "MagnumPlugins/StanfordImporter/StanfordImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct StanfordImporterBenchmark: TestSuite::Tester {
+    explicit StanfordImporterBenchmark();
+
+    void positionsFloat();
+    void positionsFloatGeneric();
+    void positionsFloatBigEndian();
+    void trianglesUnsignedByteUnsignedInt();
+    void trianglesUnsignedByteUnsignedIntBigEndian();
+    void trianglesGeneric();
+    void trianglesCompactIndices();
+    void positionsAscii();
+    void trianglesAscii();
+
+    void header();
+    void vertices();
+    void faces();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+
+    /* Data for the last vertex or face benchmark instance, to avoid
+       generating them again for each repeat */
+    std::string _lastInstanceName, _lastInstanceData;
+
+    /* Generated on first use by each benchmark and reused for the repeats */
+    std::string _positionsFloat, _positionsFloatGeneric,
+        _positionsFloatBigEndian, _trianglesUnsignedByteUnsignedInt,
+        _trianglesUnsignedByteUnsignedIntBigEndian, _trianglesGeneric,
+        _positionsAscii, _trianglesAscii;
+};
+
+namespace {
+
+constexpr std::size_t VertexCount = 1000000;
+constexpr std::size_t FaceCount = 1000000;
+
+template<bool bigEndian, class T> void append(std::string& out, T value) {
+    value = bigEndian ? Utility::Endianness::bigEndian(value) :
+        Utility::Endianness::littleEndian(value);
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::string plyHeader(const char* format, const char* vertexProperties, const std::size_t vertexCount, const char* faceProperty, const std::size_t faceCount) {
+    return std::string{"ply\nformat "} + format + " 1.0\n" +
+        "element vertex " + std::to_string(vertexCount) + "\n" +
+        vertexProperties +
+        "element face " + std::to_string(faceCount) + "\n" +
+        faceProperty +
+        "end_header\n";
+}
+
+template<bool bigEndian = false> void appendPositions(std::string& out, const std::size_t count) {
+    out.reserve(out.size() + count*12);
+    for(std::size_t i = 0; i != count; ++i) {
+        append<bigEndian>(out, Float(i%1000));
+        append<bigEndian>(out, Float(i/1000));
+        append<bigEndian>(out, Float(i%7));
+    }
+}
+
+void appendPositionsAscii(std::string& out, const std::size_t count) {
+    char buffer[64];
+    for(std::size_t i = 0; i != count; ++i) {
+        const int size = std::snprintf(buffer, sizeof(buffer), "%.6g %.6g %.4f\n", Float(i%1000)*0.125f, Float(i/1000)*0.5f, Float(i%7)/7.0f);
+        out.append(buffer, size);
+    }
+}
+
+template<class Size, class Index, bool bigEndian = false> void appendTriangles(std::string& out, const std::size_t count) {
+    out.reserve(out.size() + count*(sizeof(Size) + 3*sizeof(Index)));
+    for(std::size_t i = 0; i != count; ++i) {
+        append<bigEndian>(out, Size(3));
+        append<bigEndian>(out, Index(0));
+        append<bigEndian>(out, Index(1));
+        append<bigEndian>(out, Index(2));
+    }
+}
+
+template<class Size, class Index, bool bigEndian = false> void appendQuads(std::string& out, const std::size_t count) {
+    out.reserve(out.size() + count*(sizeof(Size) + 4*sizeof(Index)));
+    for(std::size_t i = 0; i != count; ++i) {
+        append<bigEndian>(out, Size(4));
+        append<bigEndian>(out, Index(0));
+        append<bigEndian>(out, Index(1));
+        append<bigEndian>(out, Index(2));
+        append<bigEndian>(out, Index(3));
+    }
+}
+
+/* Triangles with an 8-bit size and 32-bit indices, can be copied directly */
+std::string trianglesUnsignedByteUnsignedIntData() {
+    std::string out = plyHeader("binary_little_endian",
+        "property float x\n"
+        "property float y\n"
+        "property float z\n", 3,
+        "property list uchar uint vertex_indices\n", FaceCount);
+    appendPositions(out, 3);
+    appendTriangles<UnsignedByte, UnsignedInt>(out, FaceCount);
+    return out;
+}
+
+/* Vertex properties of various types, some of them ignored */
+constexpr const char* MixedVertexProperties =
+    "property double x\n"
+    "property double y\n"
+    "property double z\n"
+    "property float nx\n"
+    "property float ny\n"
+    "property float nz\n"
+    "property uchar red\n"
+    "property uchar green\n"
+    "property uchar blue\n"
+    "property ushort intensity\n";
+constexpr std::size_t MixedVertexSize = 3*8 + 3*4 + 3*1 + 2;
+
+template<bool bigEndian = false> void appendMixedVertices(std::string& out, const std::size_t count) {
+    out.reserve(out.size() + count*MixedVertexSize);
+    for(std::size_t i = 0; i != count; ++i) {
+        append<bigEndian>(out, Double(i%1000));
+        append<bigEndian>(out, Double(i/1000));
+        append<bigEndian>(out, Double(i%7));
+        append<bigEndian>(out, 0.0f);
+        append<bigEndian>(out, 1.0f);
+        append<bigEndian>(out, 0.0f);
+        append<bigEndian>(out, UnsignedByte(i%256));
+        append<bigEndian>(out, UnsignedByte(255));
+        append<bigEndian>(out, UnsignedByte(0));
+        append<bigEndian>(out, UnsignedShort(i%65536));
+    }
+}
+
+void appendTrianglesAscii(std::string& out, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i)
+        out += "3 " + std::to_string(i%1000) + " " + std::to_string(i%1000 + 1) + " " + std::to_string(i%1000 + 2) + "\n";
+}
+
+/* Instances with more elements are run only if this environment variable is
+   set, as they need hundreds of megabytes to several gigabytes of memory */
+constexpr const char* LargeEnvironmentVariable = "STANFORDIMPORTER_BENCHMARK_LARGE";
+constexpr std::size_t LargeCount = 1000000;
+
+constexpr struct {
+    const char* name;
+    bool bigEndian;
+    bool mixed;
+    std::size_t count;
+} VerticesData[]{
+    {"float positions, 1M", false, false, 1000000},
+    {"float positions, big-endian, 1M", true, false, 1000000},
+    {"mixed types, 1M", false, true, 1000000},
+    {"mixed types, big-endian, 1M", true, true, 1000000},
+    {"float positions, 10M", false, false, 10000000},
+    {"mixed types, 10M", false, true, 10000000},
+    {"float positions, 50M", false, false, 50000000}
+};
+
+constexpr struct {
+    const char* name;
+    bool bigEndian;
+    bool quads;
+    std::size_t count;
+} FacesData[]{
+    {"triangles, 1M", false, false, 1000000},
+    {"triangles, big-endian, 1M", true, false, 1000000},
+    {"quads, 1M", false, true, 1000000},
+    {"quads, big-endian, 1M", true, true, 1000000},
+    {"triangles, 10M", false, false, 10000000},
+    {"quads, 10M", false, true, 10000000},
+    {"triangles, 50M", false, false, 50000000}
+};
+
+}
+
+StanfordImporterBenchmark::StanfordImporterBenchmark() {
+    addBenchmarks({&StanfordImporterBenchmark::positionsFloat,
+                   &StanfordImporterBenchmark::positionsFloatGeneric,
+                   &StanfordImporterBenchmark::positionsFloatBigEndian,
+                   &StanfordImporterBenchmark::trianglesUnsignedByteUnsignedInt,
+                   &StanfordImporterBenchmark::trianglesUnsignedByteUnsignedIntBigEndian,
+                   &StanfordImporterBenchmark::trianglesGeneric,
+                   &StanfordImporterBenchmark::trianglesCompactIndices,
+                   &StanfordImporterBenchmark::positionsAscii,
+                   &StanfordImporterBenchmark::trianglesAscii}, 5);
+
+    /* Header parsing, vertex and face decoding separately. The amount of
+       processed data is in the test case description, the rate is then
+       the amount divided by the measured time. */
+    addBenchmarks({&StanfordImporterBenchmark::header}, 5);
+    addInstancedBenchmarks({&StanfordImporterBenchmark::vertices}, 5,
+        Containers::arraySize(VerticesData));
+    addInstancedBenchmarks({&StanfordImporterBenchmark::faces}, 5,
+        Containers::arraySize(FacesData));
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef STANFORDIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(STANFORDIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void StanfordImporterBenchmark::positionsFloat() {
+    if(_positionsFloat.empty()) {
+        /* Three consecutive floats, can be copied directly */
+        _positionsFloat = plyHeader("binary_little_endian",
+            "property float x\n"
+            "property float y\n"
+            "property float z\n", VertexCount,
+            "property list uchar uint vertex_indices\n", 0);
+        appendPositions(_positionsFloat, VertexCount);
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_positionsFloat.data(), _positionsFloat.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), VertexCount);
+}
+
+void StanfordImporterBenchmark::positionsFloatGeneric() {
+    if(_positionsFloatGeneric.empty()) {
+        /* The same data, but with the components in a different order, which
+           forces the generic path */
+        _positionsFloatGeneric = plyHeader("binary_little_endian",
+            "property float x\n"
+            "property float z\n"
+            "property float y\n", VertexCount,
+            "property list uchar uint vertex_indices\n", 0);
+        appendPositions(_positionsFloatGeneric, VertexCount);
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_positionsFloatGeneric.data(), _positionsFloatGeneric.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), VertexCount);
+}
+
+void StanfordImporterBenchmark::positionsFloatBigEndian() {
+    if(_positionsFloatBigEndian.empty()) {
+        /* The same data as the first, but big endian, which makes them
+           byte-swapped in batches */
+        _positionsFloatBigEndian = plyHeader("binary_big_endian",
+            "property float x\n"
+            "property float y\n"
+            "property float z\n", VertexCount,
+            "property list uchar uint vertex_indices\n", 0);
+        appendPositions<true>(_positionsFloatBigEndian, VertexCount);
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_positionsFloatBigEndian.data(), _positionsFloatBigEndian.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), VertexCount);
+    CORRADE_COMPARE(mesh->positions(0).back(), (Vector3{999.0f, 999.0f, Float((VertexCount - 1)%7)}));
+}
+
+void StanfordImporterBenchmark::trianglesUnsignedByteUnsignedInt() {
+    if(_trianglesUnsignedByteUnsignedInt.empty())
+        _trianglesUnsignedByteUnsignedInt = trianglesUnsignedByteUnsignedIntData();
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_trianglesUnsignedByteUnsignedInt.data(), _trianglesUnsignedByteUnsignedInt.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices().size(), FaceCount*3);
+}
+
+void StanfordImporterBenchmark::trianglesUnsignedByteUnsignedIntBigEndian() {
+    if(_trianglesUnsignedByteUnsignedIntBigEndian.empty()) {
+        /* The same, but big endian */
+        _trianglesUnsignedByteUnsignedIntBigEndian = plyHeader("binary_big_endian",
+            "property float x\n"
+            "property float y\n"
+            "property float z\n", 3,
+            "property list uchar uint vertex_indices\n", FaceCount);
+        appendPositions<true>(_trianglesUnsignedByteUnsignedIntBigEndian, 3);
+        appendTriangles<UnsignedByte, UnsignedInt, true>(_trianglesUnsignedByteUnsignedIntBigEndian, FaceCount);
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_trianglesUnsignedByteUnsignedIntBigEndian.data(), _trianglesUnsignedByteUnsignedIntBigEndian.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices().size(), FaceCount*3);
+    CORRADE_COMPARE(mesh->indices().back(), 2);
+}
+
+void StanfordImporterBenchmark::trianglesGeneric() {
+    if(_trianglesGeneric.empty()) {
+        /* The same, but with a 32-bit size, which forces the generic path */
+        _trianglesGeneric = plyHeader("binary_little_endian",
+            "property float x\n"
+            "property float y\n"
+            "property float z\n", 3,
+            "property list uint uint vertex_indices\n", FaceCount);
+        appendPositions(_trianglesGeneric, 3);
+        appendTriangles<UnsignedInt, UnsignedInt>(_trianglesGeneric, FaceCount);
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_trianglesGeneric.data(), _trianglesGeneric.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices().size(), FaceCount*3);
+}
+
+void StanfordImporterBenchmark::trianglesCompactIndices() {
+    if(_trianglesUnsignedByteUnsignedInt.empty())
+        _trianglesUnsignedByteUnsignedInt = trianglesUnsignedByteUnsignedIntData();
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_trianglesUnsignedByteUnsignedInt.data(), _trianglesUnsignedByteUnsignedInt.size()}));
+
+    /* The same data as in trianglesUnsignedByteUnsignedInt(), but as there
+       are just three vertices, the indices take a quarter of the memory */
+    MeshIndexType type{};
+    Containers::Optional<Containers::Array<char>> indices;
+    CORRADE_BENCHMARK(1)
+        indices = static_cast<StanfordImporter&>(*importer).compactIndices(0, type);
+
+    CORRADE_VERIFY(indices);
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(indices->size(), FaceCount*3*sizeof(UnsignedByte));
+    CORRADE_COMPARE((*indices)[indices->size() - 1], 2);
+}
+
+void StanfordImporterBenchmark::positionsAscii() {
+    if(_positionsAscii.empty()) {
+        /* ASCII positions with fractional parts, to compare against the binary
+           variants above */
+        _positionsAscii = plyHeader("ascii",
+            "property float x\n"
+            "property float y\n"
+            "property float z\n", VertexCount,
+            "property list uchar uint vertex_indices\n", 0);
+        appendPositionsAscii(_positionsAscii, VertexCount);
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_positionsAscii.data(), _positionsAscii.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), VertexCount);
+    CORRADE_COMPARE(mesh->positions(0).back(), (Vector3{124.875f, 499.5f, 0.0f}));
+}
+
+void StanfordImporterBenchmark::trianglesAscii() {
+    if(_trianglesAscii.empty()) {
+        /* ASCII triangles with multi-digit indices */
+        _trianglesAscii = plyHeader("ascii",
+            "property float x\n"
+            "property float y\n"
+            "property float z\n", 3,
+            "property list uchar uint vertex_indices\n", FaceCount);
+        appendPositionsAscii(_trianglesAscii, 3);
+        appendTrianglesAscii(_trianglesAscii, FaceCount);
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_trianglesAscii.data(), _trianglesAscii.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices().size(), FaceCount*3);
+    CORRADE_COMPARE(mesh->indices().back(), 1001);
+}
+
+void StanfordImporterBenchmark::header() {
+    /* A header with many ignored properties, without any data */
+    std::string vertexProperties = MixedVertexProperties;
+    for(std::size_t i = 0; i != 100; ++i)
+        vertexProperties += "property uchar ignored" + std::to_string(i) + "\n";
+    const std::string data = plyHeader("binary_little_endian",
+        vertexProperties.data(), 0,
+        "property list uchar uint vertex_indices\n", 0);
+    const std::size_t lineCount = std::count(data.begin(), data.end(), '\n');
+
+    /* A single header is parsed too fast to be measured reliably, parse it
+       many times */
+    constexpr std::size_t Repeats = 1000;
+    setTestCaseDescription(std::to_string(Repeats) + " headers, " +
+        std::to_string(data.size()*Repeats) + " bytes, " +
+        std::to_string(lineCount*Repeats) + " lines");
+
+    /* Don't measure printing of messages about the ignored properties */
+    Debug redirectDebug{nullptr};
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    bool opened = true;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Repeats; ++i)
+            opened = importer->openData({data.data(), data.size()}) && opened;
+    }
+
+    CORRADE_VERIFY(opened);
+}
+
+void StanfordImporterBenchmark::vertices() {
+    auto&& data = VerticesData[testCaseInstanceId()];
+
+    const std::size_t vertexSize = data.mixed ? MixedVertexSize : 12;
+    setTestCaseDescription(std::string{data.name} + ", " + std::to_string(data.count*vertexSize) + " bytes");
+
+    if(data.count > LargeCount && !std::getenv(LargeEnvironmentVariable))
+        CORRADE_SKIP("Set" << LargeEnvironmentVariable << "to run benchmarks with more than" << LargeCount << "elements.");
+
+    if(_lastInstanceName != std::string{"vertices "} + data.name) {
+        _lastInstanceName = std::string{"vertices "} + data.name;
+        _lastInstanceData = plyHeader(
+            data.bigEndian ? "binary_big_endian" : "binary_little_endian",
+            data.mixed ? MixedVertexProperties :
+                "property float x\n"
+                "property float y\n"
+                "property float z\n", data.count,
+            "property list uchar uint vertex_indices\n", 0);
+        if(data.mixed) data.bigEndian ?
+            appendMixedVertices<true>(_lastInstanceData, data.count) :
+            appendMixedVertices(_lastInstanceData, data.count);
+        else data.bigEndian ?
+            appendPositions<true>(_lastInstanceData, data.count) :
+            appendPositions(_lastInstanceData, data.count);
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    {
+        /* The mixed layout has an ignored property */
+        Debug redirectDebug{nullptr};
+        CORRADE_VERIFY(importer->openData({_lastInstanceData.data(), _lastInstanceData.size()}));
+    }
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), data.count);
+    CORRADE_COMPARE(mesh->positions(0).back(), (Vector3{Float((data.count - 1)%1000), Float((data.count - 1)/1000), Float((data.count - 1)%7)}));
+}
+
+void StanfordImporterBenchmark::faces() {
+    auto&& data = FacesData[testCaseInstanceId()];
+
+    /* The vertex data are negligible compared to the faces */
+    const std::size_t faceSize = 1 + (data.quads ? 4 : 3)*4;
+    setTestCaseDescription(std::string{data.name} + ", " + std::to_string(data.count*faceSize) + " bytes");
+
+    if(data.count > LargeCount && !std::getenv(LargeEnvironmentVariable))
+        CORRADE_SKIP("Set" << LargeEnvironmentVariable << "to run benchmarks with more than" << LargeCount << "elements.");
+
+    if(_lastInstanceName != std::string{"faces "} + data.name) {
+        _lastInstanceName = std::string{"faces "} + data.name;
+        _lastInstanceData = plyHeader(
+            data.bigEndian ? "binary_big_endian" : "binary_little_endian",
+            "property float x\n"
+            "property float y\n"
+            "property float z\n", 4,
+            "property list uchar uint vertex_indices\n", data.count);
+        if(data.bigEndian) {
+            appendPositions<true>(_lastInstanceData, 4);
+            data.quads ?
+                appendQuads<UnsignedByte, UnsignedInt, true>(_lastInstanceData, data.count) :
+                appendTriangles<UnsignedByte, UnsignedInt, true>(_lastInstanceData, data.count);
+        } else {
+            appendPositions(_lastInstanceData, 4);
+            data.quads ?
+                appendQuads<UnsignedByte, UnsignedInt>(_lastInstanceData, data.count) :
+                appendTriangles<UnsignedByte, UnsignedInt>(_lastInstanceData, data.count);
+        }
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData({_lastInstanceData.data(), _lastInstanceData.size()}));
+
+    Containers::Optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1)
+        mesh = importer->mesh3D(0);
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices().size(), data.count*(data.quads ? 6 : 3));
+    CORRADE_COMPARE(mesh->indices().back(), data.quads ? 3 : 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::StanfordImporterBenchmark)
@@ -23,13 +23,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cmath>
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Constants.h>
 #include <Magnum/Math/Vector3.h>
 #include <Magnum/Trade/AbstractImporter.h>
 #include <Magnum/Trade/MeshData3D.h>
 
+#include "MagnumPlugins/StanfordImporter/StanfordImporter.h"
+
 #include "configure.h"
 
 namespace Magnum { namespace Trade { namespace Test {
@@ -45,6 +52,7 @@ struct StanfordImporterTest: TestSuite::Tester {
 
     void unknownLine();
     void unknownElement();
+    void invalidElementCount();
 
     void unexpectedProperty();
     void invalidVertexProperty();
@@ -64,11 +72,112 @@ struct StanfordImporterTest: TestSuite::Tester {
     void bigEndian();
     void crlf();
     void ignoredVertexComponents();
+    void batchConversion();
+    void attributes();
+    void points();
+    void pointCloudBatches();
+    void pointCloudVoxelSize();
+    void pointCloudVoxelSizeManyPoints();
+    void pointCloudVoxelSizeSpecialValues();
+    void pointCloudVoxelSizeInvalid();
+
+    void weld();
+    void weldTolerance();
+    void weldAttributes();
+    void weldAttributesTolerance();
+    void weldManyVertices();
+    void weldIndexOutOfRange();
+    void weldToleranceInvalid();
+
+    void ascii();
+    void asciiInvalidValue();
+    void asciiShortFile();
+    void asciiSpecialValues();
+
+    void parallelFaces();
+    void parallelFacesInvalid();
+
+    void compactIndices();
+    void compactIndicesUnsignedShort();
+    void compactIndicesOutOfRange();
+    void compactIndicesPoints();
+
+    void openData();
+    void openTwice();
+    void importTwice();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+constexpr struct {
+    const char* name;
+    const char* element;
+    const char* message;
+} InvalidElementCountData[]{
+    {"garbage", "element vertex three\n",
+        "invalid vertex count three"},
+    {"trailing characters", "element vertex 3\nelement face 1x\n",
+        "invalid face count 1x"},
+    {"negative", "element vertex -1\n",
+        "invalid vertex count -1"},
+    {"sign", "element vertex +3\n",
+        "invalid vertex count +3"},
+    {"too large", "element vertex 3\nelement face 4294967296\n",
+        "invalid face count 4294967296"},
+    {"overflow", "element vertex 99999999999999999999999\n",
+        "invalid vertex count 99999999999999999999999"}
+};
+
+constexpr struct {
+    const char* name;
+    const char* filename;
+} BatchConversionData[]{
+    {"float, tightly packed", "float-positions.ply"},
+    {"float, strided", "float-positions-strided.ply"},
+    {"float, big endian", "float-positions-be.ply"},
+    {"float, strided, big endian, 16-bit indices", "float-positions-strided-be.ply"},
+    {"double, big endian, 16-bit indices", "double-positions-be.ply"},
+    {"short, strided", "short-positions.ply"}
+};
+
+constexpr struct {
+    const char* name;
+    const char* filename;
+} AttributesData[]{
+    {"batch positions, 8-bit colors", "attributes.ply"},
+    {"generic positions, 16-bit colors, big endian", "attributes-be.ply"},
+    {"ASCII", "attributes-ascii.ply"}
+};
+
+constexpr struct {
+    const char* name;
+    const char* filename;
+} PointsData[]{
+    {"binary", "points.ply"},
+    {"ASCII", "points-ascii.ply"}
+};
+
+constexpr struct {
+    const char* name;
+    const char* sizeType;
+    const char* indexType;
+    bool quads;
+} ParallelFacesData[]{
+    {"uint size, int indices, quads", "uint", "int", true},
+    {"uchar size, uint indices", "uchar", "uint", false},
+    {"uchar size, ushort indices", "uchar", "ushort", false},
+    {"uchar size, uint indices, quads", "uchar", "uint", true}
+};
+
+constexpr struct {
+    const char* name;
+    Float tolerance;
+} WeldManyVerticesData[]{
+    {"exact", 0.0f},
+    {"tolerance", 0.001f}
+};
+
 StanfordImporterTest::StanfordImporterTest() {
     addTests({&StanfordImporterTest::invalidSignature,
 
@@ -77,9 +186,12 @@ StanfordImporterTest::StanfordImporterTest() {
               &StanfordImporterTest::missingFormat,
 
               &StanfordImporterTest::unknownLine,
-              &StanfordImporterTest::unknownElement,
+              &StanfordImporterTest::unknownElement});
+
+    addInstancedTests({&StanfordImporterTest::invalidElementCount},
+        Containers::arraySize(InvalidElementCountData));
 
-              &StanfordImporterTest::unexpectedProperty,
+    addTests({&StanfordImporterTest::unexpectedProperty,
               &StanfordImporterTest::invalidVertexProperty,
               &StanfordImporterTest::invalidVertexType,
               &StanfordImporterTest::unknownFaceProperty,
@@ -98,6 +210,51 @@ StanfordImporterTest::StanfordImporterTest() {
               &StanfordImporterTest::crlf,
               &StanfordImporterTest::ignoredVertexComponents});
 
+    addInstancedTests({&StanfordImporterTest::batchConversion},
+        Containers::arraySize(BatchConversionData));
+
+    addInstancedTests({&StanfordImporterTest::attributes},
+        Containers::arraySize(AttributesData));
+
+    addInstancedTests({&StanfordImporterTest::points,
+                       &StanfordImporterTest::pointCloudBatches,
+                       &StanfordImporterTest::pointCloudVoxelSize},
+        Containers::arraySize(PointsData));
+
+    addTests({&StanfordImporterTest::pointCloudVoxelSizeManyPoints,
+              &StanfordImporterTest::pointCloudVoxelSizeSpecialValues,
+              &StanfordImporterTest::pointCloudVoxelSizeInvalid,
+
+              &StanfordImporterTest::weld,
+              &StanfordImporterTest::weldTolerance,
+              &StanfordImporterTest::weldAttributes,
+              &StanfordImporterTest::weldAttributesTolerance});
+
+    addInstancedTests({&StanfordImporterTest::weldManyVertices},
+        Containers::arraySize(WeldManyVerticesData));
+
+    addTests({&StanfordImporterTest::weldIndexOutOfRange,
+              &StanfordImporterTest::weldToleranceInvalid});
+
+    addTests({&StanfordImporterTest::ascii,
+              &StanfordImporterTest::asciiInvalidValue,
+              &StanfordImporterTest::asciiShortFile,
+              &StanfordImporterTest::asciiSpecialValues});
+
+    addInstancedTests({&StanfordImporterTest::parallelFaces},
+        Containers::arraySize(ParallelFacesData));
+
+    addTests({&StanfordImporterTest::parallelFacesInvalid,
+
+              &StanfordImporterTest::compactIndices,
+              &StanfordImporterTest::compactIndicesUnsignedShort,
+              &StanfordImporterTest::compactIndicesOutOfRange,
+              &StanfordImporterTest::compactIndicesPoints,
+
+              &StanfordImporterTest::openData,
+              &StanfordImporterTest::openTwice,
+              &StanfordImporterTest::importTwice});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef STANFORDIMPORTER_PLUGIN_FILENAME
@@ -110,9 +267,8 @@ void StanfordImporterTest::invalidSignature() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-signature.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid file signature bla\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-signature.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid file signature bla\n");
 }
 
 void StanfordImporterTest::invalidFormat() {
@@ -120,9 +276,8 @@ void StanfordImporterTest::invalidFormat() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-format.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid format line format binary_big_endian 1.0 extradata\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-format.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid format line format binary_big_endian 1.0 extradata\n");
 }
 
 void StanfordImporterTest::unsupportedFormat() {
@@ -130,9 +285,8 @@ void StanfordImporterTest::unsupportedFormat() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unsupported-format.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unsupported file format ascii 1.0\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unsupported-format.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unsupported file format binary_middle_endian 1.0\n");
 }
 
 void StanfordImporterTest::missingFormat() {
@@ -140,9 +294,8 @@ void StanfordImporterTest::missingFormat() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "missing-format.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): missing format line\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "missing-format.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): missing format line\n");
 }
 
 void StanfordImporterTest::unknownLine() {
@@ -150,9 +303,8 @@ void StanfordImporterTest::unknownLine() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-line.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unknown line heh\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-line.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unknown line heh\n");
 }
 
 void StanfordImporterTest::unknownElement() {
@@ -160,9 +312,24 @@ void StanfordImporterTest::unknownElement() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-element.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unknown element edge\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-element.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unknown element edge\n");
+}
+
+void StanfordImporterTest::invalidElementCount() {
+    auto&& data = InvalidElementCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    const std::string file = std::string{
+        "ply\n"
+        "format binary_little_endian 1.0\n"} + data.element;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData({file.data(), file.size()}));
+    CORRADE_COMPARE(out.str(), std::string{"Trade::StanfordImporter::openData(): "} + data.message + "\n");
 }
 
 void StanfordImporterTest::unexpectedProperty() {
@@ -170,9 +337,8 @@ void StanfordImporterTest::unexpectedProperty() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unexpected-property.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unexpected property line\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unexpected-property.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unexpected property line\n");
 }
 
 void StanfordImporterTest::invalidVertexProperty() {
@@ -180,9 +346,8 @@ void StanfordImporterTest::invalidVertexProperty() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-vertex-property.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid vertex property line property float x extradata\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-vertex-property.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid vertex property line property float x extradata\n");
 }
 
 void StanfordImporterTest::invalidVertexType() {
@@ -190,9 +355,8 @@ void StanfordImporterTest::invalidVertexType() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-vertex-type.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid vertex component type float16\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-vertex-type.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid vertex component type float16\n");
 }
 
 void StanfordImporterTest::unknownFaceProperty() {
@@ -200,9 +364,8 @@ void StanfordImporterTest::unknownFaceProperty() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-face-property.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unknown face property line property float x\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-face-property.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unknown face property line property float x\n");
 }
 
 void StanfordImporterTest::invalidFaceSizeType() {
@@ -210,9 +373,8 @@ void StanfordImporterTest::invalidFaceSizeType() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-face-size-type.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid face size type int128\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-face-size-type.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid face size type int128\n");
 }
 
 void StanfordImporterTest::invalidFaceIndexType() {
@@ -220,9 +382,8 @@ void StanfordImporterTest::invalidFaceIndexType() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-face-index-type.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid face index type int128\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-face-index-type.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid face index type int128\n");
 }
 
 void StanfordImporterTest::incompleteVertex() {
@@ -230,9 +391,8 @@ void StanfordImporterTest::incompleteVertex() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "incomplete-vertex.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): incomplete vertex specification\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "incomplete-vertex.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): incomplete vertex specification\n");
 }
 
 void StanfordImporterTest::incompleteFace() {
@@ -240,9 +400,8 @@ void StanfordImporterTest::incompleteFace() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "incomplete-face.ply")));
-    CORRADE_VERIFY(!importer->mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): incomplete face specification\n");
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "incomplete-face.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): incomplete face specification\n");
 }
 
 void StanfordImporterTest::invalidFaceSize() {
@@ -339,6 +498,626 @@ void StanfordImporterTest::ignoredVertexComponents() {
     CORRADE_COMPARE(mesh->positions(0), positions);
 }
 
+void StanfordImporterTest::batchConversion() {
+    auto&& data = BatchConversionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, data.filename)));
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    /* The first face is a triangle and is converted in a batch, the second
+       is a quad and has to go through the generic path */
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{3, 2, 4, 0, 1, 2, 0, 2, 3}));
+    CORRADE_COMPARE(mesh->positions(0), positions);
+}
+
+namespace {
+
+/* Enough faces to make the importer use more than one thread. Alternating
+   triangles and quads by default, so the face offsets can't be calculated
+   directly. */
+std::string manyFaces(const std::size_t count, const std::string& sizeType = "uint", const std::string& indexType = "int", const bool quads = true) {
+    std::string out =
+        "ply\n"
+        "format binary_little_endian 1.0\n"
+        "element vertex 0\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "element face " + std::to_string(count) + "\n"
+        "property list " + sizeType + " " + indexType + " vertex_indices\n"
+        "end_header\n";
+    const std::size_t sizeTypeSize = sizeType == "uchar" ? 1 : 4;
+    const std::size_t indexTypeSize = indexType == "ushort" ? 2 : 4;
+    for(UnsignedInt i = 0; i != count; ++i) {
+        const UnsignedInt face[]{quads && i % 2 ? 4u : 3u, i, i + 1, i + 2, i + 3};
+        out.append(reinterpret_cast<const char*>(face), sizeTypeSize);
+        for(UnsignedInt j = 0; j != face[0]; ++j)
+            out.append(reinterpret_cast<const char*>(face + j + 1), indexTypeSize);
+    }
+    return out;
+}
+
+/* Points on a 1000x(count/1000) grid with a 0.01 spacing, little-endian.
+   Enough of them to be decoded in more than one chunk. */
+std::string manyPoints(const std::size_t count) {
+    std::string out =
+        "ply\n"
+        "format binary_little_endian 1.0\n"
+        "element vertex " + std::to_string(count) + "\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "end_header\n";
+    for(UnsignedInt i = 0; i != count; ++i) {
+        const Float point[]{(i % 1000)*0.01f, (i/1000)*0.01f, 0.0f};
+        out.append(reinterpret_cast<const char*>(point), sizeof(point));
+    }
+    return out;
+}
+
+/* A triangle soup with each vertex duplicated, little-endian. The vertex
+   positions repeat every 1000 vertices with a 0.01 spacing. Enough of them
+   to be decoded in more than one chunk. */
+std::string triangleSoup(const std::size_t faceCount) {
+    std::string out =
+        "ply\n"
+        "format binary_little_endian 1.0\n"
+        "element vertex " + std::to_string(faceCount*3) + "\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "element face " + std::to_string(faceCount) + "\n"
+        "property list uchar uint vertex_indices\n"
+        "end_header\n";
+    for(UnsignedInt i = 0; i != faceCount*3; ++i) {
+        const Float point[]{(i % 1000)*0.01f, 1.0f, 0.0f};
+        out.append(reinterpret_cast<const char*>(point), sizeof(point));
+    }
+    for(UnsignedInt i = 0; i != faceCount; ++i) {
+        const UnsignedInt face[]{i*3, i*3 + 1, i*3 + 2};
+        out += '\x03';
+        out.append(reinterpret_cast<const char*>(face), sizeof(face));
+    }
+    return out;
+}
+
+}
+
+void StanfordImporterTest::attributes() {
+    auto&& data = AttributesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, data.filename)));
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), indices);
+    CORRADE_COMPARE(mesh->positions(0), positions);
+
+    CORRADE_VERIFY(mesh->hasNormals());
+    CORRADE_COMPARE(mesh->normals(0), (std::vector<Vector3>{
+        { 0.0f,  0.0f, 1.0f},
+        { 0.0f,  1.0f, 0.0f},
+        { 1.0f,  0.0f, 0.0f},
+        { 0.0f, -1.0f, 0.0f},
+        {-1.0f,  0.0f, 0.0f}
+    }));
+
+    CORRADE_VERIFY(mesh->hasTextureCoords2D());
+    CORRADE_COMPARE(mesh->textureCoords2D(0), (std::vector<Vector2>{
+        {0.0f, 1.0f},
+        {0.0f, 0.0f},
+        {1.0f, 1.0f},
+        {1.0f, 0.0f},
+        {0.5f, 0.25f}
+    }));
+
+    /* Integer colors are normalized, alpha is 1 if not present */
+    CORRADE_VERIFY(mesh->hasColors());
+    CORRADE_COMPARE(mesh->colors(0), (std::vector<Color4>{
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f, 1.0f},
+        {1.0f, 1.0f, 1.0f, 1.0f},
+        {0.2f, 0.4f, 0.6f, 1.0f}
+    }));
+}
+
+void StanfordImporterTest::points() {
+    auto&& data = PointsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, data.filename)));
+    CORRADE_COMPARE(importer->mesh3DCount(), 1);
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->positions(0), positions);
+}
+
+void StanfordImporterTest::pointCloudBatches() {
+    auto&& data = PointsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("pointCloudBatchSize", 2);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, data.filename)));
+    CORRADE_COMPARE(importer->mesh3DCount(), 3);
+
+    /* Import the batches out of order to verify they don't depend on the
+       previous import */
+    {
+        auto mesh = importer->mesh3D(1);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+        CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{positions[2], positions[3]}));
+    } {
+        auto mesh = importer->mesh3D(2);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{positions[4]}));
+    } {
+        auto mesh = importer->mesh3D(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{positions[0], positions[1]}));
+    } {
+        auto mesh = importer->mesh3D(1);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{positions[2], positions[3]}));
+    }
+}
+
+void StanfordImporterTest::pointCloudVoxelSize() {
+    auto&& data = PointsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("pointCloudVoxelSize", 4.0f);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, data.filename)));
+
+    /* The first four points fall into the same cell, the first of them is
+       kept */
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{positions[0], positions[4]}));
+}
+
+void StanfordImporterTest::pointCloudVoxelSizeManyPoints() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test data are generated for little-endian platforms.");
+    #endif
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("pointCloudVoxelSize", 1.0f);
+
+    const std::string data = manyPoints(200000);
+    CORRADE_VERIFY(importer->openData({data.data(), data.size()}));
+
+    /* The points span 10x2 unit cells */
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), 20);
+    CORRADE_COMPARE(mesh->positions(0)[19], (Vector3{9.0f, 1.0f, 0.0f}));
+}
+
+void StanfordImporterTest::pointCloudVoxelSizeSpecialValues() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("pointCloudVoxelSize", 1.0e-10f);
+
+    const char data[] =
+        "ply\n"
+        "format ascii 1.0\n"
+        "element vertex 6\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "end_header\n"
+        "1e30 0 0\n"
+        "nan 0 0\n"
+        "inf 0 0\n"
+        "1e30 0 0\n"
+        "nan 0 0\n"
+        "-1e30 0 0\n";
+    CORRADE_VERIFY(importer->openData({data, sizeof(data) - 1}));
+
+    /* The cell coordinates would overflow, so they're clamped and the huge
+       values and infinity end up in the same cell. NaNs get a cell of their
+       own. */
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), 3);
+    CORRADE_COMPARE(mesh->positions(0)[0], (Vector3{1.0e30f, 0.0f, 0.0f}));
+    CORRADE_VERIFY(std::isnan(mesh->positions(0)[1].x()));
+    CORRADE_COMPARE(mesh->positions(0)[2], (Vector3{-1.0e30f, 0.0f, 0.0f}));
+}
+
+void StanfordImporterTest::pointCloudVoxelSizeInvalid() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("pointCloudVoxelSize", -1.0f);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "points.ply")));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): expected a non-negative finite pointCloudVoxelSize but got -1\n");
+}
+
+void StanfordImporterTest::weld() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("weld", true);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "weld.ply")));
+
+    /* -0 is the same as 0, the slightly off vertex is kept */
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{0, 1, 2, 1, 3, 4}));
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.001f, 0.0f}
+    }));
+    CORRADE_VERIFY(mesh->hasColors());
+    CORRADE_COMPARE(mesh->colors(0), (std::vector<Color4>{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}
+    }));
+}
+
+void StanfordImporterTest::weldTolerance() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("weld", true);
+    importer->configuration().setValue("weldTolerance", 0.01f);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "weld.ply")));
+
+    /* The slightly off vertex is merged as well */
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{0, 1, 2, 1, 3, 2}));
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f}
+    }));
+}
+
+void StanfordImporterTest::weldAttributes() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("weld", true);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "weld-attributes.ply")));
+
+    /* Only the full duplicate is merged, vertices sharing just the position
+       are kept */
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{0, 1, 2, 1, 3, 4, 5, 6, 7}));
+    CORRADE_COMPARE(mesh->positions(0).size(), 8);
+    CORRADE_COMPARE(mesh->normals(0)[3], (Vector3{0.0f, 0.0f, -1.0f}));
+    CORRADE_COMPARE(mesh->textureCoords2D(0)[4], (Vector2{0.5f, 0.0f}));
+    CORRADE_COMPARE(mesh->textureCoords2D(0)[5], (Vector2{0.0f, 0.001f}));
+    CORRADE_COMPARE(mesh->normals(0)[6], (Vector3{0.0f, 0.001f, 1.0f}));
+}
+
+void StanfordImporterTest::weldAttributesTolerance() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("weld", true);
+    importer->configuration().setValue("weldTolerance", 0.01f);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "weld-attributes.ply")));
+
+    /* The slightly off normal and texture coordinate are merged as well,
+       the vertices differing by more than the tolerance are kept */
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{0, 1, 2, 1, 3, 4, 0, 0, 5}));
+    CORRADE_COMPARE(mesh->positions(0).size(), 6);
+    CORRADE_COMPARE(mesh->normals(0)[3], (Vector3{0.0f, 0.0f, -1.0f}));
+    CORRADE_COMPARE(mesh->textureCoords2D(0)[4], (Vector2{0.5f, 0.0f}));
+    CORRADE_COMPARE(mesh->positions(0)[5], (Vector3{1.0f, 1.0f, 0.0f}));
+}
+
+void StanfordImporterTest::weldManyVertices() {
+    auto&& data = WeldManyVerticesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test data are generated for little-endian platforms.");
+    #endif
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("weld", true);
+    importer->configuration().setValue("weldTolerance", data.tolerance);
+
+    const std::string file = triangleSoup(50000);
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), 1000);
+    CORRADE_COMPARE(mesh->positions(0)[999], (Vector3{9.99f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(mesh->indices().size(), 150000);
+    CORRADE_COMPARE(mesh->indices()[999], 999);
+    CORRADE_COMPARE(mesh->indices()[1000], 0);
+    CORRADE_COMPARE(mesh->indices().back(), 149999 % 1000);
+}
+
+void StanfordImporterTest::weldIndexOutOfRange() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test data are generated for little-endian platforms.");
+    #endif
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("weld", true);
+
+    /* The file has no vertices */
+    const std::string data = manyFaces(3);
+    CORRADE_VERIFY(importer->openData({data.data(), data.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): index 0 out of range for 0 vertices\n");
+}
+
+void StanfordImporterTest::weldToleranceInvalid() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("weld", true);
+    importer->configuration().setValue("weldTolerance", -1.0f);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "weld.ply")));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): expected a non-negative finite weldTolerance but got -1\n");
+}
+
+void StanfordImporterTest::ascii() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "ascii.ply")));
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), indices);
+    CORRADE_COMPARE(mesh->positions(0), positions);
+}
+
+void StanfordImporterTest::asciiInvalidValue() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "ascii-invalid-value.ply")));
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid value 3.5f\n");
+}
+
+void StanfordImporterTest::asciiShortFile() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "ascii-short.ply")));
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): file is too short\n");
+}
+
+void StanfordImporterTest::asciiSpecialValues() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    const char data[] =
+        "ply\n"
+        "format ascii 1.0\n"
+        "element vertex 3\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "end_header\n"
+        /* Zero stays zero with any exponent, huge exponents saturate */
+        "0e400 1e400 -1e-400\n"
+        "-0e99999 0.0e-99999 -1e99999\n"
+        /* Same as what std::strtof() accepts */
+        "nan INF -Infinity\n";
+    CORRADE_VERIFY(importer->openData({data, sizeof(data) - 1}));
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), 3);
+    CORRADE_COMPARE(mesh->positions(0)[0], (Vector3{0.0f, Constants::inf(), 0.0f}));
+    CORRADE_COMPARE(mesh->positions(0)[1], (Vector3{0.0f, 0.0f, -Constants::inf()}));
+    CORRADE_VERIFY(std::isnan(mesh->positions(0)[2].x()));
+    CORRADE_COMPARE(mesh->positions(0)[2].y(), Constants::inf());
+    CORRADE_COMPARE(mesh->positions(0)[2].z(), -Constants::inf());
+}
+
+void StanfordImporterTest::parallelFaces() {
+    auto&& data = ParallelFacesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test data are generated for little-endian platforms.");
+    #endif
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_COMPARE(importer->configuration().value<UnsignedInt>("threads"), 1);
+
+    /* Triangle-only files with a byte face size go through the batch
+       conversion in each thread */
+    const std::string file = manyFaces(100001, data.sizeType, data.indexType, data.quads);
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+
+    auto serial = importer->mesh3D(0);
+    CORRADE_VERIFY(serial);
+    CORRADE_COMPARE(serial->indices().size(), data.quads ? 50001*3 + 50000*6 : 100001*3);
+
+    importer->configuration().setValue("threads", 4);
+    auto parallel = importer->mesh3D(0);
+    CORRADE_VERIFY(parallel);
+    CORRADE_COMPARE(parallel->indices(), serial->indices());
+}
+
+void StanfordImporterTest::parallelFacesInvalid() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test data are generated for little-endian platforms.");
+    #endif
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("threads", 4);
+
+    /* Cut the last index off, which should be detected in the first pass */
+    std::string data = manyFaces(100001);
+    data.resize(data.size() - 1);
+    CORRADE_VERIFY(importer->openData({data.data(), data.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): file is too short\n");
+}
+
+void StanfordImporterTest::compactIndices() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "common.ply")));
+
+    MeshIndexType type{};
+    Containers::Optional<Containers::Array<char>> compact = static_cast<StanfordImporter&>(*importer).compactIndices(0, type);
+    CORRADE_VERIFY(compact);
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(std::vector<UnsignedInt>(reinterpret_cast<const UnsignedByte*>(compact->begin()), reinterpret_cast<const UnsignedByte*>(compact->end())), indices);
+}
+
+void StanfordImporterTest::compactIndicesUnsignedShort() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test data are generated for little-endian platforms.");
+    #endif
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    /* 300 vertices are too many for 8-bit indices */
+    std::string data =
+        "ply\n"
+        "format binary_little_endian 1.0\n"
+        "element vertex 300\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "element face 2\n"
+        "property list uchar uint vertex_indices\n"
+        "end_header\n";
+    data.append(300*12, '\0');
+    const UnsignedByte triangle[]{3, 43, 1, 0, 0, 0, 0, 0, 0, 255, 0, 0, 0};
+    const UnsignedByte quad[]{4, 0, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 43, 1, 0, 0};
+    data.append(reinterpret_cast<const char*>(triangle), sizeof(triangle));
+    data.append(reinterpret_cast<const char*>(quad), sizeof(quad));
+    CORRADE_VERIFY(importer->openData({data.data(), data.size()}));
+
+    MeshIndexType type{};
+    Containers::Optional<Containers::Array<char>> compact = static_cast<StanfordImporter&>(*importer).compactIndices(0, type);
+    CORRADE_VERIFY(compact);
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(std::vector<UnsignedInt>(reinterpret_cast<const UnsignedShort*>(compact->begin()), reinterpret_cast<const UnsignedShort*>(compact->end())),
+        (std::vector<UnsignedInt>{299, 0, 255, 0, 1, 2, 0, 2, 299}));
+}
+
+void StanfordImporterTest::compactIndicesOutOfRange() {
+    #ifdef CORRADE_TARGET_BIG_ENDIAN
+    CORRADE_SKIP("The test data are generated for little-endian platforms.");
+    #endif
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    /* The file has no vertices */
+    const std::string data = manyFaces(3);
+    CORRADE_VERIFY(importer->openData({data.data(), data.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshIndexType type{};
+    CORRADE_VERIFY(!static_cast<StanfordImporter&>(*importer).compactIndices(0, type));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::compactIndices(): index 0 out of range for 0 vertices\n");
+}
+
+void StanfordImporterTest::compactIndicesPoints() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "points.ply")));
+
+    MeshIndexType type{};
+    Containers::Optional<Containers::Array<char>> compact = static_cast<StanfordImporter&>(*importer).compactIndices(0, type);
+    CORRADE_VERIFY(compact);
+    CORRADE_VERIFY(compact->empty());
+}
+
+void StanfordImporterTest::openData() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    /* The importer makes a copy of the data, so they can go out of scope */
+    {
+        Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "common.ply"));
+        CORRADE_VERIFY(importer->openData(data));
+    }
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), indices);
+    CORRADE_COMPARE(mesh->positions(0), positions);
+}
+
+void StanfordImporterTest::openTwice() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "common.ply")));
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "ascii.ply")));
+
+    /* The header from the second file should be used */
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), indices);
+    CORRADE_COMPARE(mesh->positions(0), positions);
+}
+
+void StanfordImporterTest::importTwice() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "common.ply")));
+
+    /* Verify that everything is working the same way on second use */
+    {
+        auto mesh = importer->mesh3D(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->indices(), indices);
+        CORRADE_COMPARE(mesh->positions(0), positions);
+    } {
+        auto mesh = importer->mesh3D(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->indices(), indices);
+        CORRADE_COMPARE(mesh->positions(0), positions);
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::StanfordImporterTest)
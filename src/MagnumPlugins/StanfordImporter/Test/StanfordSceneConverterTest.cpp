@@ -0,0 +1,317 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Vector3.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/MeshData3D.h>
+
+#include "MagnumPlugins/StanfordImporter/StanfordSceneConverter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct StanfordSceneConverterTest: TestSuite::Tester {
+    explicit StanfordSceneConverterTest();
+
+    void convertToData();
+    void convertToDataPoints();
+    void convertToDataUnsupportedPrimitive();
+    void convertToDataNonIndexed();
+    void convertToDataAttributeSizeMismatch();
+
+    void convertToFile();
+
+    void stream();
+    void streamManyVertices();
+    void streamVerticesAfterFaces();
+    void streamTooManyVertices();
+    void streamAttributeMismatch();
+    void streamIncomplete();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+StanfordSceneConverterTest::StanfordSceneConverterTest() {
+    addTests({&StanfordSceneConverterTest::convertToData,
+              &StanfordSceneConverterTest::convertToDataPoints,
+              &StanfordSceneConverterTest::convertToDataUnsupportedPrimitive,
+              &StanfordSceneConverterTest::convertToDataNonIndexed,
+              &StanfordSceneConverterTest::convertToDataAttributeSizeMismatch,
+
+              &StanfordSceneConverterTest::convertToFile,
+
+              &StanfordSceneConverterTest::stream,
+              &StanfordSceneConverterTest::streamManyVertices,
+              &StanfordSceneConverterTest::streamVerticesAfterFaces,
+              &StanfordSceneConverterTest::streamTooManyVertices,
+              &StanfordSceneConverterTest::streamAttributeMismatch,
+              &StanfordSceneConverterTest::streamIncomplete});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef STANFORDIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(STANFORDIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    Utility::Directory::mkpath(STANFORDIMPORTER_TEST_OUTPUT_DIR);
+}
+
+namespace {
+
+const std::vector<UnsignedInt> Indices{0, 1, 2, 0, 2, 3, 3, 2, 4};
+
+const std::vector<Vector3> Positions{
+    {1.0f, 3.0f, 2.0f},
+    {1.0f, 1.0f, 2.0f},
+    {3.0f, 3.0f, 2.0f},
+    {3.0f, 1.0f, 2.0f},
+    {5.0f, 3.0f, 9.0f}
+};
+
+const std::vector<Vector3> Normals{
+    { 0.0f,  0.0f, 1.0f},
+    { 0.0f,  1.0f, 0.0f},
+    { 1.0f,  0.0f, 0.0f},
+    { 0.0f, -1.0f, 0.0f},
+    {-1.0f,  0.0f, 0.0f}
+};
+
+const std::vector<Vector2> TextureCoordinates{
+    {0.0f, 1.0f},
+    {0.0f, 0.0f},
+    {1.0f, 1.0f},
+    {1.0f, 0.0f},
+    {0.5f, 0.25f}
+};
+
+/* Exactly representable as normalized bytes */
+const std::vector<Color4> Colors{
+    {1.0f, 0.0f, 0.0f, 1.0f},
+    {0.0f, 1.0f, 0.0f, 0.2f},
+    {0.0f, 0.0f, 1.0f, 0.4f},
+    {1.0f, 1.0f, 1.0f, 0.6f},
+    {0.2f, 0.4f, 0.6f, 0.0f}
+};
+
+}
+
+void StanfordSceneConverterTest::convertToData() {
+    StanfordSceneConverter converter;
+    Containers::Optional<Containers::Array<char>> data = converter.convertToData(MeshData3D{MeshPrimitive::Triangles, Indices, {Positions}, {Normals}, {TextureCoordinates}, {Colors}});
+    CORRADE_VERIFY(data);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData(*data));
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->indices(), Indices);
+    CORRADE_COMPARE(mesh->positions(0), Positions);
+    CORRADE_VERIFY(mesh->hasNormals());
+    CORRADE_COMPARE(mesh->normals(0), Normals);
+    CORRADE_VERIFY(mesh->hasTextureCoords2D());
+    CORRADE_COMPARE(mesh->textureCoords2D(0), TextureCoordinates);
+    CORRADE_VERIFY(mesh->hasColors());
+    CORRADE_COMPARE(mesh->colors(0), Colors);
+}
+
+void StanfordSceneConverterTest::convertToDataPoints() {
+    StanfordSceneConverter converter;
+    Containers::Optional<Containers::Array<char>> data = converter.convertToData(MeshData3D{MeshPrimitive::Points, {}, {Positions}, {}, {}, {}});
+    CORRADE_VERIFY(data);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openData(*data));
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->positions(0), Positions);
+    CORRADE_VERIFY(!mesh->hasNormals());
+    CORRADE_VERIFY(!mesh->hasTextureCoords2D());
+    CORRADE_VERIFY(!mesh->hasColors());
+}
+
+void StanfordSceneConverterTest::convertToDataUnsupportedPrimitive() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(!converter.convertToData(MeshData3D{MeshPrimitive::Lines, {}, {Positions}, {}, {}, {}}));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::convertToData(): unsupported primitive MeshPrimitive::Lines\n");
+}
+
+void StanfordSceneConverterTest::convertToDataNonIndexed() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(!converter.convertToData(MeshData3D{MeshPrimitive::Triangles, {}, {Positions}, {}, {}, {}}));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::convertToData(): non-indexed meshes are not supported\n");
+}
+
+void StanfordSceneConverterTest::convertToDataAttributeSizeMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(!converter.convertToData(MeshData3D{MeshPrimitive::Triangles, Indices, {Positions}, {{Normals.begin(), Normals.begin() + 3}}, {}, {}}));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::convertToData(): expected 5 normals but got 3\n");
+}
+
+void StanfordSceneConverterTest::convertToFile() {
+    const std::string filename = Utility::Directory::join(STANFORDIMPORTER_TEST_OUTPUT_DIR, "convert.ply");
+
+    const MeshData3D mesh{MeshPrimitive::Triangles, Indices, {Positions}, {Normals}, {}, {Colors}};
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(converter.convertToFile(filename, mesh));
+    CORRADE_VERIFY(!converter.isStreaming());
+
+    /* Should be the same as when converting to data */
+    Containers::Optional<Containers::Array<char>> data = converter.convertToData(mesh);
+    CORRADE_VERIFY(data);
+    Containers::Array<char> file = Utility::Directory::read(filename);
+    CORRADE_COMPARE(std::string(file, file.size()), std::string(*data, data->size()));
+}
+
+void StanfordSceneConverterTest::stream() {
+    const std::string filename = Utility::Directory::join(STANFORDIMPORTER_TEST_OUTPUT_DIR, "stream.ply");
+
+    /* Vertices and faces added in two parts each */
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(converter.beginFile(filename, StanfordSceneConverter::Attribute::TextureCoordinates, 5, 3));
+    CORRADE_VERIFY(converter.isStreaming());
+    CORRADE_VERIFY(converter.addVertices(
+        Containers::arrayView(Positions.data(), 2), nullptr,
+        Containers::arrayView(TextureCoordinates.data(), 2)));
+    CORRADE_VERIFY(converter.addVertices(
+        Containers::arrayView(Positions.data() + 2, 3), nullptr,
+        Containers::arrayView(TextureCoordinates.data() + 2, 3)));
+    CORRADE_VERIFY(converter.addFaces(Containers::arrayView(Indices.data(), 3)));
+    CORRADE_VERIFY(converter.addFaces(Containers::arrayView(Indices.data() + 3, 6)));
+    CORRADE_VERIFY(converter.endFile());
+    CORRADE_VERIFY(!converter.isStreaming());
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openFile(filename));
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), Indices);
+    CORRADE_COMPARE(mesh->positions(0), Positions);
+    CORRADE_VERIFY(!mesh->hasNormals());
+    CORRADE_VERIFY(mesh->hasTextureCoords2D());
+    CORRADE_COMPARE(mesh->textureCoords2D(0), TextureCoordinates);
+    CORRADE_VERIFY(!mesh->hasColors());
+}
+
+void StanfordSceneConverterTest::streamManyVertices() {
+    const std::string filename = Utility::Directory::join(STANFORDIMPORTER_TEST_OUTPUT_DIR, "stream-many-vertices.ply");
+
+    /* More than fits into a single block, added in uneven parts */
+    std::vector<Vector3> positions(200000);
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = Vector3{Float(i), Float(i%7), 0.5f};
+
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(converter.beginFile(filename, {}, positions.size(), 0));
+    CORRADE_VERIFY(converter.addVertices(Containers::arrayView(positions.data(), 12345)));
+    CORRADE_VERIFY(converter.addVertices(Containers::arrayView(positions.data() + 12345, positions.size() - 12345)));
+    CORRADE_VERIFY(converter.endFile());
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    CORRADE_VERIFY(importer->openFile(filename));
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(mesh->positions(0).size(), positions.size());
+    CORRADE_COMPARE(mesh->positions(0)[12344], positions[12344]);
+    CORRADE_COMPARE(mesh->positions(0)[12345], positions[12345]);
+    CORRADE_COMPARE(mesh->positions(0).back(), positions.back());
+}
+
+void StanfordSceneConverterTest::streamVerticesAfterFaces() {
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(converter.beginFile(Utility::Directory::join(STANFORDIMPORTER_TEST_OUTPUT_DIR, "stream-error.ply"), {}, 5, 3));
+    CORRADE_VERIFY(converter.addVertices(Containers::arrayView(Positions.data(), 5)));
+    CORRADE_VERIFY(converter.addFaces(Containers::arrayView(Indices.data(), 3)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.addVertices(Containers::arrayView(Positions.data(), 0)));
+    CORRADE_VERIFY(!converter.isStreaming());
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::addVertices(): vertices have to be added before faces\n");
+}
+
+void StanfordSceneConverterTest::streamTooManyVertices() {
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(converter.beginFile(Utility::Directory::join(STANFORDIMPORTER_TEST_OUTPUT_DIR, "stream-error.ply"), {}, 4, 0));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.addVertices(Containers::arrayView(Positions.data(), 5)));
+    CORRADE_VERIFY(!converter.isStreaming());
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::addVertices(): expected only 4 vertices but got 5\n");
+}
+
+void StanfordSceneConverterTest::streamAttributeMismatch() {
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(converter.beginFile(Utility::Directory::join(STANFORDIMPORTER_TEST_OUTPUT_DIR, "stream-error.ply"), StanfordSceneConverter::Attribute::Colors, 5, 0));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.addVertices(Containers::arrayView(Positions.data(), 5),
+        Containers::arrayView(Normals.data(), 5)));
+    CORRADE_VERIFY(!converter.isStreaming());
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::addVertices(): expected 0 normals but got 5\n");
+}
+
+void StanfordSceneConverterTest::streamIncomplete() {
+    StanfordSceneConverter converter;
+    CORRADE_VERIFY(converter.beginFile(Utility::Directory::join(STANFORDIMPORTER_TEST_OUTPUT_DIR, "stream-error.ply"), {}, 5, 3));
+    CORRADE_VERIFY(converter.addVertices(Containers::arrayView(Positions.data(), 5)));
+    CORRADE_VERIFY(converter.addFaces(Containers::arrayView(Indices.data(), 3)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.endFile());
+    CORRADE_VERIFY(!converter.isStreaming());
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::endFile(): expected 5 vertices and 3 faces but got 5 and 1\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::StanfordSceneConverterTest)
@@ -0,0 +1,1254 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GltfParser.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+/* Only the model definitions are needed, the tinygltf parser is not compiled
+   in. Include like this instead of "MagnumExternal/TinyGltf/tiny_gltf.h" so
+   we can include it as a system header and suppress warnings. */
+#include "tiny_gltf.h"
+
+/* MSVC doesn't define __SSE2__, but it's always available on x64 and with
+   /arch:SSE2 on x86 */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP == 2)
+#define MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+namespace {
+
+/* Tokenizer */
+
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline bool isHexDigit(const char c) {
+    return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+#ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+inline UnsignedInt firstSetBit(const UnsignedInt mask) {
+    #ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+    #else
+    return __builtin_ctz(mask);
+    #endif
+}
+#endif
+
+std::size_t skipWhitespace(const char* const data, const std::size_t size, std::size_t i) {
+    /* Tokens in minified files are not separated by any whitespace at all, so
+       check that first before going wide for indentation */
+    if(i == size || !isWhitespace(data[i])) return i;
+
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+    const __m128i space = _mm_set1_epi8(' '), newline = _mm_set1_epi8('\n'),
+        carriageReturn = _mm_set1_epi8('\r'), tab = _mm_set1_epi8('\t');
+    for(; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i whitespace = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, newline)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, carriageReturn), _mm_cmpeq_epi8(v, tab)));
+        const UnsignedInt mask = ~UnsignedInt(_mm_movemask_epi8(whitespace)) & 0xffff;
+        if(mask) return i + firstSetBit(mask);
+    }
+    #endif
+
+    while(i != size && isWhitespace(data[i])) ++i;
+    return i;
+}
+
+/* Finds the closing quote of a string starting at i, which is right after
+   the opening quote. Returns 0 and fills the error offset on failure, sets
+   the escaped flag if the string contains escape sequences. */
+std::size_t scanString(const char* const data, const std::size_t size, std::size_t i, bool& escaped, std::size_t& errorOffset, const char*& error) {
+    for(;;) {
+        /* Look for a quote, a backslash or a control character sixteen bytes
+           at a time, the control character check is done as an unsigned
+           max() with 0x1f compared to 0x1f */
+        #ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+        const __m128i quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\'),
+            control = _mm_set1_epi8(0x1f);
+        for(; i + 16 <= size; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const UnsignedInt mask = _mm_movemask_epi8(_mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                _mm_cmpeq_epi8(_mm_max_epu8(v, control), control)));
+            if(mask) {
+                i += firstSetBit(mask);
+                break;
+            }
+        }
+        #endif
+
+        while(i != size && data[i] != '"' && data[i] != '\\' && UnsignedByte(data[i]) >= 0x20) ++i;
+
+        if(i == size) {
+            errorOffset = i;
+            error = "unterminated string";
+            return 0;
+        }
+
+        if(data[i] == '"') return i;
+
+        if(data[i] != '\\') {
+            errorOffset = i;
+            error = "unescaped control character in a string";
+            return 0;
+        }
+
+        escaped = true;
+        if(i + 1 == size) {
+            errorOffset = i;
+            error = "unterminated string";
+            return 0;
+        }
+
+        const char c = data[i + 1];
+        if(c == '"' || c == '\\' || c == '/' || c == 'b' || c == 'f' || c == 'n' || c == 'r' || c == 't') {
+            i += 2;
+        } else if(c == 'u' && i + 6 <= size && isHexDigit(data[i + 2]) && isHexDigit(data[i + 3]) && isHexDigit(data[i + 4]) && isHexDigit(data[i + 5])) {
+            i += 6;
+        } else {
+            errorOffset = i;
+            error = "invalid escape sequence";
+            return 0;
+        }
+    }
+}
+
+/* Finds the end of a number starting at i. Returns 0 if the number is
+   malformed, sets the fractional flag if there's a fractional part or an
+   exponent. */
+std::size_t scanNumber(const char* const data, const std::size_t size, std::size_t i, bool& fractional) {
+    if(data[i] == '-') ++i;
+    if(i == size) return 0;
+
+    if(data[i] == '0') ++i;
+    else if(isDigit(data[i])) while(i != size && isDigit(data[i])) ++i;
+    else return 0;
+
+    if(i != size && data[i] == '.') {
+        ++i;
+        if(i == size || !isDigit(data[i])) return 0;
+        while(i != size && isDigit(data[i])) ++i;
+        fractional = true;
+    }
+
+    if(i != size && (data[i] == 'e' || data[i] == 'E')) {
+        ++i;
+        if(i != size && (data[i] == '+' || data[i] == '-')) ++i;
+        if(i == size || !isDigit(data[i])) return 0;
+        while(i != size && isDigit(data[i])) ++i;
+        fractional = true;
+    }
+
+    return i;
+}
+
+/* Line and column for an error message, calculated only on failure */
+std::string errorLocation(const char* const data, const std::size_t offset) {
+    std::size_t line = 1, column = 1;
+    for(std::size_t i = 0; i != offset; ++i) {
+        if(data[i] == '\n') {
+            ++line;
+            column = 1;
+        } else ++column;
+    }
+
+    return "JSON error at line " + std::to_string(line) + ", column " + std::to_string(column) + ": ";
+}
+
+/* Value conversion */
+
+constexpr double Powers10[]{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+    1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* The number was already validated by the tokenizer. Integers and decimals
+   with at most 15 significant digits and a small exponent (which covers
+   basically all numbers in glTF files) are converted exactly using a single
+   multiplication or division, as both operands are representable exactly
+   and the result is correctly rounded. The rest goes through the standard
+   library, with the classic locale so the decimal point is not affected by
+   the global locale. */
+double parseNumber(const char* const begin, const std::size_t size) {
+    const char* p = begin;
+    const char* const end = begin + size;
+
+    const bool negative = *p == '-';
+    if(negative) ++p;
+
+    std::uint64_t mantissa = 0;
+    Int digits = 0;
+    Int exponent = 0;
+    for(; p != end && isDigit(*p); ++p) {
+        if(digits < 19) {
+            mantissa = mantissa*10 + (*p - '0');
+            if(mantissa) ++digits;
+        } else ++exponent;
+    }
+
+    if(p != end && *p == '.') {
+        for(++p; p != end && isDigit(*p); ++p) {
+            if(digits < 19) {
+                mantissa = mantissa*10 + (*p - '0');
+                if(mantissa) ++digits;
+                --exponent;
+            }
+        }
+    }
+
+    if(p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        const bool negativeExponent = *p == '-';
+        if(*p == '-' || *p == '+') ++p;
+        Int value = 0;
+        for(; p != end && isDigit(*p); ++p)
+            if(value < 100000) value = value*10 + (*p - '0');
+        exponent += negativeExponent ? -value : value;
+    }
+
+    if(digits <= 15 && exponent >= -22 && exponent <= 22) {
+        const double value = exponent < 0 ?
+            double(mantissa)/Powers10[-exponent] :
+            double(mantissa)*Powers10[exponent];
+        return negative ? -value : value;
+    }
+
+    std::istringstream in{std::string{begin, size}};
+    in.imbue(std::locale::classic());
+    double value;
+    in >> value;
+    return value;
+}
+
+void appendUtf8(std::string& out, const UnsignedInt codepoint) {
+    if(codepoint < 0x80) {
+        out += char(codepoint);
+    } else if(codepoint < 0x800) {
+        out += char(0xc0|(codepoint >> 6));
+        out += char(0x80|(codepoint & 0x3f));
+    } else if(codepoint < 0x10000) {
+        out += char(0xe0|(codepoint >> 12));
+        out += char(0x80|((codepoint >> 6) & 0x3f));
+        out += char(0x80|(codepoint & 0x3f));
+    } else {
+        out += char(0xf0|(codepoint >> 18));
+        out += char(0x80|((codepoint >> 12) & 0x3f));
+        out += char(0x80|((codepoint >> 6) & 0x3f));
+        out += char(0x80|(codepoint & 0x3f));
+    }
+}
+
+UnsignedInt parseHex4(const char* const p) {
+    UnsignedInt value = 0;
+    for(std::size_t i = 0; i != 4; ++i) {
+        const char c = p[i];
+        value = value*16 + (isDigit(c) ? c - '0' : (c|0x20) - 'a' + 10);
+    }
+    return value;
+}
+
+/* The escapes were already validated by the tokenizer */
+std::string unescape(const char* p, const std::size_t size) {
+    const char* const end = p + size;
+    std::string out;
+    out.reserve(size);
+    while(p != end) {
+        if(*p != '\\') {
+            out += *p++;
+            continue;
+        }
+
+        const char c = p[1];
+        p += 2;
+        switch(c) {
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                UnsignedInt codepoint = parseHex4(p);
+                p += 4;
+                /* Combine a surrogate pair, lone surrogates are passed
+                   through as-is */
+                if(codepoint >= 0xd800 && codepoint < 0xdc00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                    const UnsignedInt low = parseHex4(p + 2);
+                    if(low >= 0xdc00 && low < 0xe000) {
+                        codepoint = 0x10000 + ((codepoint - 0xd800) << 10) + (low - 0xdc00);
+                        p += 6;
+                    }
+                }
+                appendUtf8(out, codepoint);
+            } break;
+            default: out += c;
+        }
+    }
+
+    return out;
+}
+
+/* Token access for the glTF reader */
+
+struct Json {
+    const char* data;
+    const std::vector<JsonToken>& tokens;
+
+    const JsonToken& operator[](const UnsignedInt i) const { return tokens[i]; }
+
+    bool isObject(const UnsignedInt i) const { return tokens[i].type == JsonToken::Type::Object; }
+    bool isArray(const UnsignedInt i) const { return tokens[i].type == JsonToken::Type::Array; }
+    bool isNumber(const UnsignedInt i) const { return tokens[i].type == JsonToken::Type::Number; }
+    bool isString(const UnsignedInt i) const { return tokens[i].type == JsonToken::Type::String; }
+
+    /* Compares a key with a string literal. Escaped keys are compared
+       after unescaping, which is practically never needed. */
+    template<std::size_t size> bool keyIs(const UnsignedInt i, const char(&name)[size]) const {
+        const JsonToken& token = tokens[i];
+        if(token.flag) return string(i) == name;
+        return token.size == size - 1 && std::memcmp(data + token.begin, name, size - 1) == 0;
+    }
+
+    std::string string(const UnsignedInt i) const {
+        const JsonToken& token = tokens[i];
+        return token.flag ? unescape(data + token.begin, token.size) :
+            std::string{data + token.begin, token.size};
+    }
+
+    double number(const UnsignedInt i) const {
+        return parseNumber(data + tokens[i].begin, tokens[i].size);
+    }
+};
+
+/* Calls f(key, value) for each member of an object, stops and returns false
+   if f returns false */
+template<class F> bool forEachMember(const Json& json, const UnsignedInt object, F f) {
+    UnsignedInt key = object + 1;
+    for(UnsignedInt i = 0, end = json[object].size; i != end; ++i) {
+        if(!f(key, key + 1)) return false;
+        key = json[key + 1].next;
+    }
+    return true;
+}
+
+/* Calls f(index, value) for each element of an array, stops and returns
+   false if f returns false */
+template<class F> bool forEachElement(const Json& json, const UnsignedInt array, F f) {
+    UnsignedInt value = array + 1;
+    for(UnsignedInt i = 0, end = json[array].size; i != end; ++i) {
+        if(!f(i, value)) return false;
+        value = json[value].next;
+    }
+    return true;
+}
+
+/* Typed property accessors, these return false if the value has a
+   different type and leave the output untouched in that case */
+
+bool number(const Json& json, const UnsignedInt i, double& out) {
+    if(!json.isNumber(i)) return false;
+    out = json.number(i);
+    return true;
+}
+
+/* Converting a double that's not representable in the integer type is
+   undefined, so non-finite, fractional and out-of-range values are rejected
+   upfront. The upper bound is exclusive because the maximum of 64-bit types
+   isn't representable as a double and rounds up to the next power of two. */
+template<class T> bool toInteger(const double value, T& out) {
+    /* Negated so NaNs fail as well */
+    if(!(value >= double(std::numeric_limits<T>::min()) && value < double(std::numeric_limits<T>::max()) + 1.0) || std::floor(value) != value)
+        return false;
+    out = T(value);
+    return true;
+}
+
+template<class T> bool integer(const Json& json, const UnsignedInt i, T& out) {
+    if(!json.isNumber(i)) return false;
+    T result;
+    if(!toInteger(json.number(i), result)) return false;
+    out = result;
+    return true;
+}
+
+bool string(const Json& json, const UnsignedInt i, std::string& out) {
+    if(!json.isString(i)) return false;
+    out = json.string(i);
+    return true;
+}
+
+bool boolean(const Json& json, const UnsignedInt i, bool& out) {
+    if(json[i].type == JsonToken::Type::True) out = true;
+    else if(json[i].type == JsonToken::Type::False) out = false;
+    else return false;
+    return true;
+}
+
+bool numberArray(const Json& json, const UnsignedInt i, std::vector<double>& out) {
+    if(!json.isArray(i)) return false;
+    out.clear();
+    out.reserve(json[i].size);
+    return forEachElement(json, i, [&](UnsignedInt, const UnsignedInt value) {
+        if(!json.isNumber(value)) return false;
+        out.push_back(json.number(value));
+        return true;
+    });
+}
+
+bool integerArray(const Json& json, const UnsignedInt i, std::vector<int>& out) {
+    if(!json.isArray(i)) return false;
+    out.clear();
+    out.reserve(json[i].size);
+    return forEachElement(json, i, [&](UnsignedInt, const UnsignedInt value) {
+        int result;
+        if(!json.isNumber(value) || !toInteger(json.number(value), result))
+            return false;
+        out.push_back(result);
+        return true;
+    });
+}
+
+bool integerMap(const Json& json, const UnsignedInt i, std::map<std::string, int>& out) {
+    if(!json.isObject(i)) return false;
+    out.clear();
+    return forEachMember(json, i, [&](const UnsignedInt key, const UnsignedInt value) {
+        int result;
+        if(!json.isNumber(value) || !toInteger(json.number(value), result))
+            return false;
+        out[json.string(key)] = result;
+        return true;
+    });
+}
+
+/* Nesting depth of generic values. The tokenizer has no limit, so without
+   it a maliciously nested extras property would overflow the stack. */
+constexpr UnsignedInt MaxValueDepth = 64;
+
+/* Generic value, used for extensions and extras. Nulls as well as empty
+   objects and arrays are dropped, integers that fit into an int are
+   distinguished from other numbers. Objects and arrays nested deeper than
+   MaxValueDepth are dropped as well. */
+tinygltf::Value value(const Json& json, const UnsignedInt i, const UnsignedInt depth = 0) {
+    switch(json[i].type) {
+        case JsonToken::Type::Object: {
+            if(depth == MaxValueDepth) return {};
+            tinygltf::Value::Object object;
+            forEachMember(json, i, [&](const UnsignedInt key, const UnsignedInt member) {
+                tinygltf::Value v = value(json, member, depth + 1);
+                if(v.Type() != tinygltf::NULL_TYPE)
+                    object[json.string(key)] = std::move(v);
+                return true;
+            });
+            return object.empty() ? tinygltf::Value{} : tinygltf::Value{object};
+        }
+        case JsonToken::Type::Array: {
+            if(depth == MaxValueDepth) return {};
+            tinygltf::Value::Array array;
+            array.reserve(json[i].size);
+            forEachElement(json, i, [&](UnsignedInt, const UnsignedInt element) {
+                tinygltf::Value v = value(json, element, depth + 1);
+                if(v.Type() != tinygltf::NULL_TYPE)
+                    array.push_back(std::move(v));
+                return true;
+            });
+            return array.empty() ? tinygltf::Value{} : tinygltf::Value{array};
+        }
+        case JsonToken::Type::String:
+            return tinygltf::Value{json.string(i)};
+        case JsonToken::Type::Number: {
+            int result;
+            return !json[i].flag && toInteger(json.number(i), result) ?
+                tinygltf::Value{result} : tinygltf::Value{json.number(i)};
+        }
+        case JsonToken::Type::True:
+            return tinygltf::Value{true};
+        case JsonToken::Type::False:
+            return tinygltf::Value{false};
+        case JsonToken::Type::Null:
+            return {};
+    }
+
+    return {}; /* LCOV_EXCL_LINE */
+}
+
+void extensions(const Json& json, const UnsignedInt i, tinygltf::ExtensionMap& out) {
+    if(!json.isObject(i)) return;
+    forEachMember(json, i, [&](const UnsignedInt key, const UnsignedInt extension) {
+        if(json.isObject(extension))
+            out[json.string(key)] = value(json, extension);
+        return true;
+    });
+}
+
+/* Material parameter, which is either a string, a number array, a number,
+   an object with number values or a bool */
+bool parameter(const Json& json, const UnsignedInt i, tinygltf::Parameter& out) {
+    switch(json[i].type) {
+        case JsonToken::Type::String:
+            out.string_value = json.string(i);
+            return true;
+        case JsonToken::Type::Array:
+            return numberArray(json, i, out.number_array);
+        case JsonToken::Type::Number:
+            out.number_value = json.number(i);
+            out.has_number_value = true;
+            return true;
+        case JsonToken::Type::Object:
+            forEachMember(json, i, [&](const UnsignedInt key, const UnsignedInt value) {
+                if(json.isNumber(value))
+                    out.json_double_value[json.string(key)] = json.number(value);
+                return true;
+            });
+            return true;
+        case JsonToken::Type::True:
+        case JsonToken::Type::False:
+            out.bool_value = json[i].type == JsonToken::Type::True;
+            return true;
+        case JsonToken::Type::Null:
+            return false;
+    }
+
+    return false; /* LCOV_EXCL_LINE */
+}
+
+bool propertyError(std::string& error, const char* const property, const char* const object, const std::size_t id) {
+    error = std::string{"missing or invalid "} + property + " property in " + object + " " + std::to_string(id);
+    return false;
+}
+
+/* glTF objects */
+
+void parseAsset(const Json& json, const UnsignedInt object, tinygltf::Asset& asset) {
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "version")) string(json, value, asset.version);
+        else if(json.keyIs(key, "generator")) string(json, value, asset.generator);
+        else if(json.keyIs(key, "minVersion")) string(json, value, asset.minVersion);
+        else if(json.keyIs(key, "copyright")) string(json, value, asset.copyright);
+        else if(json.keyIs(key, "extensions")) extensions(json, value, asset.extensions);
+        else if(json.keyIs(key, "extras")) asset.extras = Implementation::value(json, value);
+        return true;
+    });
+}
+
+bool parseBuffer(const Json& json, const UnsignedInt object, tinygltf::Buffer& buffer, const std::size_t id, std::string& error) {
+    bool hasByteLength = false;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        /* The data are not loaded, so the length is only checked for
+           presence */
+        if(json.keyIs(key, "byteLength")) hasByteLength = json.isNumber(value);
+        else if(json.keyIs(key, "uri")) string(json, value, buffer.uri);
+        else if(json.keyIs(key, "name")) string(json, value, buffer.name);
+        else if(json.keyIs(key, "extras")) buffer.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(!hasByteLength) return propertyError(error, "byteLength", "buffer", id);
+    return true;
+}
+
+bool parseBufferView(const Json& json, const UnsignedInt object, tinygltf::BufferView& bufferView, const std::size_t id, std::string& error) {
+    bool hasBuffer = false, hasByteLength = false;
+    bufferView.target = 0;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "buffer")) hasBuffer = integer(json, value, bufferView.buffer);
+        else if(json.keyIs(key, "byteOffset")) integer(json, value, bufferView.byteOffset);
+        else if(json.keyIs(key, "byteLength")) hasByteLength = integer(json, value, bufferView.byteLength);
+        else if(json.keyIs(key, "byteStride")) integer(json, value, bufferView.byteStride);
+        else if(json.keyIs(key, "target")) integer(json, value, bufferView.target);
+        else if(json.keyIs(key, "name")) string(json, value, bufferView.name);
+        else if(json.keyIs(key, "extensions")) extensions(json, value, bufferView.extensions);
+        else if(json.keyIs(key, "extras")) bufferView.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(!hasBuffer) return propertyError(error, "buffer", "buffer view", id);
+    if(!hasByteLength) return propertyError(error, "byteLength", "buffer view", id);
+    if(bufferView.byteStride > 252 || bufferView.byteStride % 4)
+        return propertyError(error, "byteStride", "buffer view", id);
+    if(bufferView.target != TINYGLTF_TARGET_ARRAY_BUFFER && bufferView.target != TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER)
+        bufferView.target = 0;
+    return true;
+}
+
+bool parseSparse(const Json& json, const UnsignedInt object, tinygltf::Accessor& accessor, const std::size_t id, std::string& error) {
+    accessor.sparse.isSparse = true;
+    bool hasCount = false, hasIndexBufferView = false,
+        hasIndexComponentType = false, hasValueBufferView = false;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "count")) hasCount = integer(json, value, accessor.sparse.count);
+        else if(json.keyIs(key, "indices") && json.isObject(value)) forEachMember(json, value, [&](const UnsignedInt key, const UnsignedInt value) {
+            if(json.keyIs(key, "bufferView")) hasIndexBufferView = integer(json, value, accessor.sparse.indices.bufferView);
+            else if(json.keyIs(key, "byteOffset")) integer(json, value, accessor.sparse.indices.byteOffset);
+            else if(json.keyIs(key, "componentType")) hasIndexComponentType = integer(json, value, accessor.sparse.indices.componentType);
+            return true;
+        });
+        else if(json.keyIs(key, "values") && json.isObject(value)) forEachMember(json, value, [&](const UnsignedInt key, const UnsignedInt value) {
+            if(json.keyIs(key, "bufferView")) hasValueBufferView = integer(json, value, accessor.sparse.values.bufferView);
+            else if(json.keyIs(key, "byteOffset")) integer(json, value, accessor.sparse.values.byteOffset);
+            return true;
+        });
+        return true;
+    });
+
+    if(!hasCount) return propertyError(error, "sparse count", "accessor", id);
+    if(!hasIndexBufferView) return propertyError(error, "sparse indices bufferView", "accessor", id);
+    if(!hasIndexComponentType) return propertyError(error, "sparse indices componentType", "accessor", id);
+    if(!hasValueBufferView) return propertyError(error, "sparse values bufferView", "accessor", id);
+    return true;
+}
+
+bool parseAccessor(const Json& json, const UnsignedInt object, tinygltf::Accessor& accessor, const std::size_t id, std::string& error) {
+    bool hasComponentType = false, hasCount = false;
+    accessor.byteOffset = 0;
+    accessor.normalized = false;
+    accessor.type = -1;
+    UnsignedInt sparse = 0;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "bufferView")) integer(json, value, accessor.bufferView);
+        else if(json.keyIs(key, "byteOffset")) integer(json, value, accessor.byteOffset);
+        else if(json.keyIs(key, "normalized")) boolean(json, value, accessor.normalized);
+        else if(json.keyIs(key, "componentType")) hasComponentType = integer(json, value, accessor.componentType);
+        else if(json.keyIs(key, "count")) hasCount = integer(json, value, accessor.count);
+        else if(json.keyIs(key, "type") && json.isString(value)) {
+            if(json.keyIs(value, "SCALAR")) accessor.type = TINYGLTF_TYPE_SCALAR;
+            else if(json.keyIs(value, "VEC2")) accessor.type = TINYGLTF_TYPE_VEC2;
+            else if(json.keyIs(value, "VEC3")) accessor.type = TINYGLTF_TYPE_VEC3;
+            else if(json.keyIs(value, "VEC4")) accessor.type = TINYGLTF_TYPE_VEC4;
+            else if(json.keyIs(value, "MAT2")) accessor.type = TINYGLTF_TYPE_MAT2;
+            else if(json.keyIs(value, "MAT3")) accessor.type = TINYGLTF_TYPE_MAT3;
+            else if(json.keyIs(value, "MAT4")) accessor.type = TINYGLTF_TYPE_MAT4;
+        }
+        else if(json.keyIs(key, "name")) string(json, value, accessor.name);
+        else if(json.keyIs(key, "min")) numberArray(json, value, accessor.minValues);
+        else if(json.keyIs(key, "max")) numberArray(json, value, accessor.maxValues);
+        else if(json.keyIs(key, "sparse") && json.isObject(value)) sparse = value;
+        else if(json.keyIs(key, "extras")) accessor.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(!hasComponentType || accessor.componentType < TINYGLTF_COMPONENT_TYPE_BYTE || accessor.componentType > TINYGLTF_COMPONENT_TYPE_DOUBLE)
+        return propertyError(error, "componentType", "accessor", id);
+    if(!hasCount) return propertyError(error, "count", "accessor", id);
+    if(accessor.type == -1) return propertyError(error, "type", "accessor", id);
+    if(sparse && !parseSparse(json, sparse, accessor, id, error)) return false;
+    return true;
+}
+
+bool parseTargets(const Json& json, const UnsignedInt array, std::vector<std::map<std::string, int>>& targets) {
+    if(!json.isArray(array)) return true;
+    targets.resize(json[array].size);
+    return forEachElement(json, array, [&](const UnsignedInt i, const UnsignedInt target) {
+        return integerMap(json, target, targets[i]);
+    });
+}
+
+bool parsePrimitive(const Json& json, const UnsignedInt object, tinygltf::Primitive& primitive, const std::size_t id, std::string& error) {
+    bool hasAttributes = false, validTargets = true;
+    primitive.mode = TINYGLTF_MODE_TRIANGLES;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "attributes")) hasAttributes = integerMap(json, value, primitive.attributes);
+        else if(json.keyIs(key, "indices")) integer(json, value, primitive.indices);
+        else if(json.keyIs(key, "material")) integer(json, value, primitive.material);
+        else if(json.keyIs(key, "mode")) integer(json, value, primitive.mode);
+        else if(json.keyIs(key, "targets")) validTargets = parseTargets(json, value, primitive.targets);
+        else if(json.keyIs(key, "extras")) primitive.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(!hasAttributes) return propertyError(error, "primitive attributes", "mesh", id);
+    if(!validTargets) return propertyError(error, "primitive targets", "mesh", id);
+    return true;
+}
+
+bool parseMesh(const Json& json, const UnsignedInt object, tinygltf::Mesh& mesh, const std::size_t id, std::string& error) {
+    UnsignedInt primitives = 0;
+    bool validTargets = true;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "primitives") && json.isArray(value)) primitives = value;
+        else if(json.keyIs(key, "name")) string(json, value, mesh.name);
+        else if(json.keyIs(key, "weights")) numberArray(json, value, mesh.weights);
+        else if(json.keyIs(key, "targets")) validTargets = parseTargets(json, value, mesh.targets);
+        else if(json.keyIs(key, "extensions")) extensions(json, value, mesh.extensions);
+        else if(json.keyIs(key, "extras")) mesh.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(!validTargets) return propertyError(error, "targets", "mesh", id);
+
+    /* The importer treats each primitive as a separate mesh, so there has to
+       be at least one */
+    if(!primitives || !json[primitives].size)
+        return propertyError(error, "primitives", "mesh", id);
+    mesh.primitives.resize(json[primitives].size);
+    return forEachElement(json, primitives, [&](const UnsignedInt i, const UnsignedInt primitive) {
+        if(!json.isObject(primitive)) return propertyError(error, "primitives", "mesh", id);
+        return parsePrimitive(json, primitive, mesh.primitives[i], id, error);
+    });
+}
+
+bool parseNode(const Json& json, const UnsignedInt object, tinygltf::Node& node, const std::size_t id, std::string& error) {
+    bool hasMatrix = false, validChildren = true;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "name")) string(json, value, node.name);
+        else if(json.keyIs(key, "mesh")) integer(json, value, node.mesh);
+        else if(json.keyIs(key, "camera")) integer(json, value, node.camera);
+        else if(json.keyIs(key, "skin")) integer(json, value, node.skin);
+        else if(json.keyIs(key, "children") && json.isArray(value)) validChildren = integerArray(json, value, node.children);
+        else if(json.keyIs(key, "matrix")) hasMatrix = numberArray(json, value, node.matrix);
+        else if(json.keyIs(key, "translation")) numberArray(json, value, node.translation);
+        else if(json.keyIs(key, "rotation")) numberArray(json, value, node.rotation);
+        else if(json.keyIs(key, "scale")) numberArray(json, value, node.scale);
+        else if(json.keyIs(key, "weights")) numberArray(json, value, node.weights);
+        else if(json.keyIs(key, "extensions")) extensions(json, value, node.extensions);
+        else if(json.keyIs(key, "extras")) node.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(!validChildren) return propertyError(error, "children", "node", id);
+
+    /* Matrix and TRS are exclusive, the matrix has a precedence */
+    if(hasMatrix) {
+        node.translation.clear();
+        node.rotation.clear();
+        node.scale.clear();
+    } else node.matrix.clear();
+    return true;
+}
+
+bool parseScene(const Json& json, const UnsignedInt object, tinygltf::Scene& scene, const std::size_t id, std::string& error) {
+    bool validNodes = true;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "name")) string(json, value, scene.name);
+        else if(json.keyIs(key, "nodes")) validNodes = integerArray(json, value, scene.nodes);
+        else if(json.keyIs(key, "extensions")) extensions(json, value, scene.extensions);
+        else if(json.keyIs(key, "extras")) scene.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(!validNodes) return propertyError(error, "nodes", "scene", id);
+    return true;
+}
+
+void parseMaterial(const Json& json, const UnsignedInt object, tinygltf::Material& material) {
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "pbrMetallicRoughness")) {
+            if(json.isObject(value)) forEachMember(json, value, [&](const UnsignedInt key, const UnsignedInt value) {
+                tinygltf::Parameter p{};
+                if(parameter(json, value, p))
+                    material.values[json.string(key)] = std::move(p);
+                return true;
+            });
+        } else if(json.keyIs(key, "extensions")) {
+            extensions(json, value, material.extensions);
+        } else if(json.keyIs(key, "extras")) {
+            material.extras = Implementation::value(json, value);
+
+        /* Everything else (including the name, for compatibility with the
+           original tinygltf parser) goes to additional values */
+        } else {
+            if(json.keyIs(key, "name")) string(json, value, material.name);
+            tinygltf::Parameter p{};
+            if(parameter(json, value, p))
+                material.additionalValues[json.string(key)] = std::move(p);
+        }
+        return true;
+    });
+}
+
+bool parseImage(const Json& json, const UnsignedInt object, tinygltf::Image& image, const std::size_t id, std::string& error) {
+    UnsignedInt bufferView = 0, uri = 0;
+    image.width = image.height = image.component = 0;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "bufferView")) bufferView = value;
+        else if(json.keyIs(key, "uri")) uri = value;
+        else if(json.keyIs(key, "name")) string(json, value, image.name);
+        else if(json.keyIs(key, "mimeType")) string(json, value, image.mimeType);
+        else if(json.keyIs(key, "width")) integer(json, value, image.width);
+        else if(json.keyIs(key, "height")) integer(json, value, image.height);
+        else if(json.keyIs(key, "extras")) image.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(bufferView && uri) {
+        error = "image " + std::to_string(id) + " has both bufferView and uri properties";
+        return false;
+    }
+
+    if(bufferView) {
+        if(!integer(json, bufferView, image.bufferView))
+            return propertyError(error, "bufferView", "image", id);
+        return true;
+    }
+
+    /* Data URIs are kept and decoded only when the image is imported, take
+       the MIME type from the URI if it's not specified explicitly */
+    if(!uri || !string(json, uri, image.uri))
+        return propertyError(error, "uri", "image", id);
+    if(image.mimeType.empty() && image.uri.compare(0, 5, "data:") == 0) {
+        const std::size_t end = image.uri.find_first_of(";,", 5);
+        if(end != std::string::npos) image.mimeType = image.uri.substr(5, end - 5);
+    }
+    return true;
+}
+
+void parseTexture(const Json& json, const UnsignedInt object, tinygltf::Texture& texture) {
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "sampler")) integer(json, value, texture.sampler);
+        else if(json.keyIs(key, "source")) integer(json, value, texture.source);
+        else if(json.keyIs(key, "name")) string(json, value, texture.name);
+        else if(json.keyIs(key, "extensions")) extensions(json, value, texture.extensions);
+        else if(json.keyIs(key, "extras")) texture.extras = Implementation::value(json, value);
+        return true;
+    });
+}
+
+void parseSampler(const Json& json, const UnsignedInt object, tinygltf::Sampler& sampler) {
+    sampler.minFilter = TINYGLTF_TEXTURE_FILTER_NEAREST_MIPMAP_LINEAR;
+    sampler.magFilter = TINYGLTF_TEXTURE_FILTER_LINEAR;
+    sampler.wrapR = 0;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "minFilter")) integer(json, value, sampler.minFilter);
+        else if(json.keyIs(key, "magFilter")) integer(json, value, sampler.magFilter);
+        else if(json.keyIs(key, "wrapS")) integer(json, value, sampler.wrapS);
+        else if(json.keyIs(key, "wrapT")) integer(json, value, sampler.wrapT);
+        else if(json.keyIs(key, "name")) string(json, value, sampler.name);
+        else if(json.keyIs(key, "extras")) sampler.extras = Implementation::value(json, value);
+        return true;
+    });
+}
+
+bool parseAnimation(const Json& json, const UnsignedInt object, tinygltf::Animation& animation, const std::size_t id, std::string& error) {
+    UnsignedInt channels = 0, samplers = 0;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "channels") && json.isArray(value)) channels = value;
+        else if(json.keyIs(key, "samplers") && json.isArray(value)) samplers = value;
+        else if(json.keyIs(key, "name")) string(json, value, animation.name);
+        else if(json.keyIs(key, "extras")) animation.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(channels) {
+        animation.channels.resize(json[channels].size);
+        if(!forEachElement(json, channels, [&](const UnsignedInt i, const UnsignedInt object) {
+            if(!json.isObject(object)) return false;
+            tinygltf::AnimationChannel& channel = animation.channels[i];
+            bool hasSampler = false, hasNode = false, hasPath = false;
+            forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+                if(json.keyIs(key, "sampler")) hasSampler = integer(json, value, channel.sampler);
+                else if(json.keyIs(key, "target") && json.isObject(value)) forEachMember(json, value, [&](const UnsignedInt key, const UnsignedInt value) {
+                    if(json.keyIs(key, "node")) hasNode = integer(json, value, channel.target_node);
+                    else if(json.keyIs(key, "path")) hasPath = string(json, value, channel.target_path);
+                    return true;
+                });
+                else if(json.keyIs(key, "extras")) channel.extras = Implementation::value(json, value);
+                return true;
+            });
+            return hasSampler && hasNode && hasPath;
+        })) return propertyError(error, "channels", "animation", id);
+    }
+
+    if(samplers) {
+        animation.samplers.resize(json[samplers].size);
+        if(!forEachElement(json, samplers, [&](const UnsignedInt i, const UnsignedInt object) {
+            if(!json.isObject(object)) return false;
+            tinygltf::AnimationSampler& sampler = animation.samplers[i];
+            bool hasInput = false, hasOutput = false;
+            forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+                if(json.keyIs(key, "input")) hasInput = integer(json, value, sampler.input);
+                else if(json.keyIs(key, "output")) hasOutput = integer(json, value, sampler.output);
+                else if(json.keyIs(key, "interpolation")) string(json, value, sampler.interpolation);
+                else if(json.keyIs(key, "extras")) sampler.extras = Implementation::value(json, value);
+                return true;
+            });
+            return hasInput && hasOutput;
+        })) return propertyError(error, "samplers", "animation", id);
+    }
+
+    return true;
+}
+
+bool parseSkin(const Json& json, const UnsignedInt object, tinygltf::Skin& skin, const std::size_t id, std::string& error) {
+    bool hasJoints = false;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "joints")) hasJoints = integerArray(json, value, skin.joints);
+        else if(json.keyIs(key, "skeleton")) integer(json, value, skin.skeleton);
+        else if(json.keyIs(key, "inverseBindMatrices")) integer(json, value, skin.inverseBindMatrices);
+        else if(json.keyIs(key, "name")) string(json, value, skin.name);
+        return true;
+    });
+
+    if(!hasJoints) return propertyError(error, "joints", "skin", id);
+    return true;
+}
+
+bool parseCamera(const Json& json, const UnsignedInt object, tinygltf::Camera& camera, const std::size_t id, std::string& error) {
+    UnsignedInt orthographic = 0, perspective = 0;
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "type")) string(json, value, camera.type);
+        else if(json.keyIs(key, "orthographic") && json.isObject(value)) orthographic = value;
+        else if(json.keyIs(key, "perspective") && json.isObject(value)) perspective = value;
+        else if(json.keyIs(key, "name")) string(json, value, camera.name);
+        else if(json.keyIs(key, "extensions")) extensions(json, value, camera.extensions);
+        else if(json.keyIs(key, "extras")) camera.extras = Implementation::value(json, value);
+        return true;
+    });
+
+    if(camera.type == "orthographic") {
+        if(!orthographic) return propertyError(error, "orthographic", "camera", id);
+        tinygltf::OrthographicCamera& o = camera.orthographic;
+        bool hasXmag = false, hasYmag = false, hasZfar = false, hasZnear = false;
+        double value;
+        forEachMember(json, orthographic, [&](const UnsignedInt key, const UnsignedInt v) {
+            if(json.keyIs(key, "xmag") && (hasXmag = number(json, v, value))) o.xmag = float(value);
+            else if(json.keyIs(key, "ymag") && (hasYmag = number(json, v, value))) o.ymag = float(value);
+            else if(json.keyIs(key, "zfar") && (hasZfar = number(json, v, value))) o.zfar = float(value);
+            else if(json.keyIs(key, "znear") && (hasZnear = number(json, v, value))) o.znear = float(value);
+            else if(json.keyIs(key, "extensions")) extensions(json, v, o.extensions);
+            else if(json.keyIs(key, "extras")) o.extras = Implementation::value(json, v);
+            return true;
+        });
+        if(!hasXmag || !hasYmag || !hasZfar || !hasZnear)
+            return propertyError(error, "orthographic", "camera", id);
+
+    } else if(camera.type == "perspective") {
+        if(!perspective) return propertyError(error, "perspective", "camera", id);
+        tinygltf::PerspectiveCamera& p = camera.perspective;
+        bool hasYfov = false, hasZnear = false;
+        double value;
+        forEachMember(json, perspective, [&](const UnsignedInt key, const UnsignedInt v) {
+            if(json.keyIs(key, "yfov") && (hasYfov = number(json, v, value))) p.yfov = float(value);
+            else if(json.keyIs(key, "znear") && (hasZnear = number(json, v, value))) p.znear = float(value);
+            else if(json.keyIs(key, "zfar") && number(json, v, value)) p.zfar = float(value);
+            else if(json.keyIs(key, "aspectRatio") && number(json, v, value)) p.aspectRatio = float(value);
+            else if(json.keyIs(key, "extensions")) extensions(json, v, p.extensions);
+            else if(json.keyIs(key, "extras")) p.extras = Implementation::value(json, v);
+            return true;
+        });
+        if(!hasYfov || !hasZnear)
+            return propertyError(error, "perspective", "camera", id);
+
+    } else return propertyError(error, "type", "camera", id);
+
+    return true;
+}
+
+void parseLights(const Json& json, const UnsignedInt object, std::vector<tinygltf::Light>& lights) {
+    forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(!json.keyIs(key, "lights") || !json.isArray(value)) return true;
+        lights.resize(json[value].size);
+        forEachElement(json, value, [&](const UnsignedInt i, const UnsignedInt object) {
+            if(json.isObject(object)) forEachMember(json, object, [&](const UnsignedInt key, const UnsignedInt value) {
+                if(json.keyIs(key, "name")) string(json, value, lights[i].name);
+                else if(json.keyIs(key, "type")) string(json, value, lights[i].type);
+                else if(json.keyIs(key, "color")) numberArray(json, value, lights[i].color);
+                return true;
+            });
+            return true;
+        });
+        return true;
+    });
+}
+
+/* Parses all objects of a top-level array, allocating the output just once
+   as the element count is known upfront */
+template<class T, class F> bool parseArray(const Json& json, const UnsignedInt array, std::vector<T>& out, const char* const name, std::string& error, F parse) {
+    if(!json.isArray(array)) return true;
+    out.resize(json[array].size);
+    return forEachElement(json, array, [&](const UnsignedInt i, const UnsignedInt object) {
+        if(!json.isObject(object)) {
+            error = std::string{name} + " " + std::to_string(i) + " is not an object";
+            return false;
+        }
+        return parse(object, out[i], i);
+    });
+}
+
+}
+
+bool tokenizeJson(const Containers::ArrayView<const char> data, std::vector<JsonToken>& tokens, std::string& error) {
+    /* Offsets are 32-bit to keep the tokens small */
+    if(data.size() > std::numeric_limits<UnsignedInt>::max()) {
+        error = "JSON data too large";
+        return false;
+    }
+
+    const char* const d = data.data();
+    const std::size_t size = data.size();
+
+    /* Most tokens in glTF files span at least eight bytes including the
+       separators, which avoids most reallocations without overallocating
+       too much */
+    tokens.clear();
+    tokens.reserve(size/8 + 1);
+
+    /* Indices of currently open objects and arrays */
+    std::vector<UnsignedInt> stack;
+    enum class Expect {
+        Value, ValueOrArrayEnd, KeyOrObjectEnd, Key, Colon, CommaOrEnd, End
+    } expect = Expect::Value;
+
+    const char* message = nullptr;
+    std::size_t i = 0;
+    for(;;) {
+        i = skipWhitespace(d, size, i);
+        if(i == size) break;
+        const char c = d[i];
+
+        /* Separators */
+        if(expect == Expect::Colon) {
+            if(c != ':') {
+                message = "expected a colon";
+                break;
+            }
+            ++i;
+            expect = Expect::Value;
+            continue;
+        }
+
+        if(expect == Expect::End) {
+            message = "unexpected data after the root value";
+            break;
+        }
+
+        /* End of an object or array */
+        const bool top = !stack.empty();
+        const JsonToken::Type topType = top ? tokens[stack.back()].type : JsonToken::Type::Null;
+        if((c == '}' && topType == JsonToken::Type::Object && (expect == Expect::CommaOrEnd || expect == Expect::KeyOrObjectEnd)) ||
+           (c == ']' && topType == JsonToken::Type::Array && (expect == Expect::CommaOrEnd || expect == Expect::ValueOrArrayEnd))) {
+            tokens[stack.back()].next = tokens.size();
+            stack.pop_back();
+            ++i;
+            expect = stack.empty() ? Expect::End : Expect::CommaOrEnd;
+            continue;
+        }
+
+        if(expect == Expect::CommaOrEnd) {
+            if(c != ',') {
+                message = topType == JsonToken::Type::Object ?
+                    "expected a comma or an end of object" :
+                    "expected a comma or an end of array";
+                break;
+            }
+            ++i;
+            expect = topType == JsonToken::Type::Object ? Expect::Key : Expect::Value;
+            continue;
+        }
+
+        /* Object keys */
+        if(expect == Expect::Key || expect == Expect::KeyOrObjectEnd) {
+            if(c != '"') {
+                message = "expected a string key";
+                break;
+            }
+
+            bool escaped = false;
+            const std::size_t end = scanString(d, size, i + 1, escaped, i, message);
+            if(!end) break;
+            ++tokens[stack.back()].size;
+            tokens.push_back({JsonToken::Type::String, escaped, UnsignedInt(i + 1), UnsignedInt(end - i - 1), UnsignedInt(tokens.size() + 1)});
+            i = end + 1;
+            expect = Expect::Colon;
+            continue;
+        }
+
+        /* Values. Object members were counted with the key already. */
+        if(topType == JsonToken::Type::Array) ++tokens[stack.back()].size;
+
+        if(c == '{' || c == '[') {
+            stack.push_back(tokens.size());
+            tokens.push_back({c == '{' ? JsonToken::Type::Object : JsonToken::Type::Array, false, UnsignedInt(i), 0, 0});
+            ++i;
+            expect = c == '{' ? Expect::KeyOrObjectEnd : Expect::ValueOrArrayEnd;
+            continue;
+        }
+
+        if(c == '"') {
+            bool escaped = false;
+            const std::size_t end = scanString(d, size, i + 1, escaped, i, message);
+            if(!end) break;
+            tokens.push_back({JsonToken::Type::String, escaped, UnsignedInt(i + 1), UnsignedInt(end - i - 1), UnsignedInt(tokens.size() + 1)});
+            i = end + 1;
+
+        } else if(c == '-' || isDigit(c)) {
+            bool fractional = false;
+            const std::size_t end = scanNumber(d, size, i, fractional);
+            if(!end) {
+                message = "invalid number";
+                break;
+            }
+            tokens.push_back({JsonToken::Type::Number, fractional, UnsignedInt(i), UnsignedInt(end - i), UnsignedInt(tokens.size() + 1)});
+            i = end;
+
+        } else if(c == 't' && size - i >= 4 && std::memcmp(d + i, "true", 4) == 0) {
+            tokens.push_back({JsonToken::Type::True, false, UnsignedInt(i), 4, UnsignedInt(tokens.size() + 1)});
+            i += 4;
+        } else if(c == 'f' && size - i >= 5 && std::memcmp(d + i, "false", 5) == 0) {
+            tokens.push_back({JsonToken::Type::False, false, UnsignedInt(i), 5, UnsignedInt(tokens.size() + 1)});
+            i += 5;
+        } else if(c == 'n' && size - i >= 4 && std::memcmp(d + i, "null", 4) == 0) {
+            tokens.push_back({JsonToken::Type::Null, false, UnsignedInt(i), 4, UnsignedInt(tokens.size() + 1)});
+            i += 4;
+
+        } else {
+            message = "expected a value";
+            break;
+        }
+
+        expect = stack.empty() ? Expect::End : Expect::CommaOrEnd;
+    }
+
+    if(!message && expect != Expect::End) message = "unexpected end of data";
+    if(message) {
+        error = errorLocation(d, i) + message;
+        return false;
+    }
+
+    return true;
+}
+
+bool parseGltf(const Containers::ArrayView<const char> data, tinygltf::Model& model, std::string& error) {
+    if(data.size() < 4) {
+        error = "JSON string too short.";
+        return false;
+    }
+
+    std::vector<JsonToken> tokens;
+    if(!tokenizeJson(data, tokens, error)) return false;
+
+    if(tokens[0].type != JsonToken::Type::Object) {
+        error = "root element is not a JSON object";
+        return false;
+    }
+
+    /* Everything is filled in a single pass over the root object in the
+       order in which it appears in the file. There are no dependencies
+       between the top-level arrays, references are validated only when
+       given object is imported. */
+    const Json json{data.data(), tokens};
+    model.defaultScene = -1;
+    return forEachMember(json, 0, [&](const UnsignedInt key, const UnsignedInt value) {
+        if(json.keyIs(key, "asset")) {
+            if(json.isObject(value)) parseAsset(json, value, model.asset);
+        } else if(json.keyIs(key, "scene")) {
+            integer(json, value, model.defaultScene);
+        } else if(json.keyIs(key, "extensionsUsed") || json.keyIs(key, "extensionsRequired")) {
+            if(json.isArray(value)) forEachElement(json, value, [&](UnsignedInt, const UnsignedInt element) {
+                if(json.isString(element))
+                    (json.keyIs(key, "extensionsUsed") ? model.extensionsUsed : model.extensionsRequired).push_back(json.string(element));
+                return true;
+            });
+        } else if(json.keyIs(key, "accessors")) {
+            return parseArray(json, value, model.accessors, "accessor", error, [&](const UnsignedInt object, tinygltf::Accessor& accessor, const std::size_t id) {
+                return parseAccessor(json, object, accessor, id, error);
+            });
+        } else if(json.keyIs(key, "animations")) {
+            return parseArray(json, value, model.animations, "animation", error, [&](const UnsignedInt object, tinygltf::Animation& animation, const std::size_t id) {
+                return parseAnimation(json, object, animation, id, error);
+            });
+        } else if(json.keyIs(key, "buffers")) {
+            return parseArray(json, value, model.buffers, "buffer", error, [&](const UnsignedInt object, tinygltf::Buffer& buffer, const std::size_t id) {
+                return parseBuffer(json, object, buffer, id, error);
+            });
+        } else if(json.keyIs(key, "bufferViews")) {
+            return parseArray(json, value, model.bufferViews, "buffer view", error, [&](const UnsignedInt object, tinygltf::BufferView& bufferView, const std::size_t id) {
+                return parseBufferView(json, object, bufferView, id, error);
+            });
+        } else if(json.keyIs(key, "cameras")) {
+            return parseArray(json, value, model.cameras, "camera", error, [&](const UnsignedInt object, tinygltf::Camera& camera, const std::size_t id) {
+                return parseCamera(json, object, camera, id, error);
+            });
+        } else if(json.keyIs(key, "images")) {
+            return parseArray(json, value, model.images, "image", error, [&](const UnsignedInt object, tinygltf::Image& image, const std::size_t id) {
+                return parseImage(json, object, image, id, error);
+            });
+        } else if(json.keyIs(key, "materials")) {
+            return parseArray(json, value, model.materials, "material", error, [&](const UnsignedInt object, tinygltf::Material& material, std::size_t) {
+                parseMaterial(json, object, material);
+                return true;
+            });
+        } else if(json.keyIs(key, "meshes")) {
+            return parseArray(json, value, model.meshes, "mesh", error, [&](const UnsignedInt object, tinygltf::Mesh& mesh, const std::size_t id) {
+                return parseMesh(json, object, mesh, id, error);
+            });
+        } else if(json.keyIs(key, "nodes")) {
+            return parseArray(json, value, model.nodes, "node", error, [&](const UnsignedInt object, tinygltf::Node& node, const std::size_t id) {
+                return parseNode(json, object, node, id, error);
+            });
+        } else if(json.keyIs(key, "samplers")) {
+            return parseArray(json, value, model.samplers, "sampler", error, [&](const UnsignedInt object, tinygltf::Sampler& sampler, std::size_t) {
+                parseSampler(json, object, sampler);
+                return true;
+            });
+        } else if(json.keyIs(key, "scenes")) {
+            return parseArray(json, value, model.scenes, "scene", error, [&](const UnsignedInt object, tinygltf::Scene& scene, const std::size_t id) {
+                return parseScene(json, object, scene, id, error);
+            });
+        } else if(json.keyIs(key, "skins")) {
+            return parseArray(json, value, model.skins, "skin", error, [&](const UnsignedInt object, tinygltf::Skin& skin, const std::size_t id) {
+                return parseSkin(json, object, skin, id, error);
+            });
+        } else if(json.keyIs(key, "textures")) {
+            return parseArray(json, value, model.textures, "texture", error, [&](const UnsignedInt object, tinygltf::Texture& texture, std::size_t) {
+                parseTexture(json, object, texture);
+                return true;
+            });
+        } else if(json.keyIs(key, "extensions")) {
+            extensions(json, value, model.extensions);
+            if(json.isObject(value)) forEachMember(json, value, [&](const UnsignedInt key, const UnsignedInt value) {
+                if(json.keyIs(key, "KHR_lights_cmn") && json.isObject(value))
+                    parseLights(json, value, model.lights);
+                return true;
+            });
+        } else if(json.keyIs(key, "extras")) {
+            model.extras = Implementation::value(json, value);
+        }
+
+        return true;
+    });
+}
+
+}}}
@@ -0,0 +1,70 @@
+#ifndef Magnum_Trade_Implementation_GltfParser_h
+#define Magnum_Trade_Implementation_GltfParser_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/Magnum.h>
+
+namespace tinygltf { class Model; }
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* A JSON token. The tokens are stored in a flat array in document order,
+   each value is followed by all its children and `next` is the index of the
+   first token after them, so any value can be skipped in constant time.
+   Object children are alternating keys and values. */
+struct JsonToken {
+    enum class Type: UnsignedByte {
+        Object, Array, String, Number, True, False, Null
+    };
+
+    Type type;
+    /* The string contains escape sequences or the number has a fractional
+       part or an exponent */
+    bool flag;
+    /* Offset of the token in the input, for strings without the quotes */
+    UnsignedInt begin;
+    /* Byte size of a string or a number, member count of an object or
+       element count of an array */
+    UnsignedInt size;
+    UnsignedInt next;
+};
+
+/* Tokenizes a whole JSON document in a single pass. Only the structure and
+   the syntax is validated, strings and numbers are converted on demand by the
+   consumer. Returns false and fills the error if the input is malformed. */
+bool tokenizeJson(Containers::ArrayView<const char> data, std::vector<JsonToken>& tokens, std::string& error);
+
+/* Fills an empty model from the JSON part of a glTF file. Buffer and image
+   data are not loaded, only their URIs are kept. Returns false and fills the
+   error on failure. */
+bool parseGltf(Containers::ArrayView<const char> data, tinygltf::Model& model, std::string& error);
+
+}}}
+
+#endif
@@ -0,0 +1,489 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshOptDecoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+
+/* MSVC doesn't define __SSE2__, but it's always available on x64 and with
+   /arch:SSE2 on x86 */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP == 2)
+#define MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+namespace {
+
+/* Vertex codec. The data are split into blocks of at most 256 vertices, each
+   block stores every byte of the vertex as a separate channel of
+   zigzag-encoded deltas against the previous vertex. The channel is then
+   packed in groups of 16 bytes, each using either 0, 2, 4 or 8 bits per
+   value. */
+constexpr UnsignedByte VertexHeader = 0xa0;
+constexpr std::size_t VertexBlockSizeBytes = 8192;
+constexpr std::size_t VertexBlockMaxSize = 256;
+constexpr std::size_t ByteGroupSize = 16;
+/* Largest possible size of an encoded byte group. The encoder pads the data
+   with a tail so there's always at least this much left when decoding a
+   valid stream, which saves a bounds check for every byte. */
+constexpr std::size_t ByteGroupDecodeLimit = 24;
+constexpr std::size_t TailMaxSize = 32;
+
+std::size_t vertexBlockSize(const std::size_t stride) {
+    /* The whole block has to fit into 8 kB and be a multiple of the group
+       size */
+    return std::min((VertexBlockSizeBytes/stride) & ~(ByteGroupSize - 1), VertexBlockMaxSize);
+}
+
+/* Values with 2 and 4 bits are packed starting from the most significant
+   bits, a value with all bits set is an escape and the actual byte is stored
+   after the packed data */
+const UnsignedByte* decodeBytesGroup(const UnsignedByte* const data, UnsignedByte* const out, const UnsignedInt bitsLog2) {
+    if(bitsLog2 == 0) {
+        std::memset(out, 0, ByteGroupSize);
+        return data;
+    }
+
+    if(bitsLog2 == 3) {
+        std::memcpy(out, data, ByteGroupSize);
+        return data + ByteGroupSize;
+    }
+
+    const UnsignedInt bits = 1 << bitsLog2;
+    const UnsignedByte escape = (1 << bits) - 1;
+    const UnsignedByte* extra = data + ByteGroupSize*bits/8;
+    for(std::size_t i = 0; i != ByteGroupSize; ++i) {
+        const UnsignedByte value = (data[i*bits/8] >> (8 - bits - i*bits%8)) & escape;
+        out[i] = value == escape ? *extra++ : value;
+    }
+
+    return extra;
+}
+
+const UnsignedByte* decodeBytes(const UnsignedByte* data, const UnsignedByte* const end, UnsignedByte* const out, const std::size_t size) {
+    /* Two bits per group in the header */
+    const UnsignedByte* const header = data;
+    const std::size_t headerSize = (size/ByteGroupSize + 3)/4;
+    if(std::size_t(end - data) < headerSize) return nullptr;
+    data += headerSize;
+
+    for(std::size_t i = 0; i != size; i += ByteGroupSize) {
+        if(std::size_t(end - data) < ByteGroupDecodeLimit) return nullptr;
+        const std::size_t group = i/ByteGroupSize;
+        data = decodeBytesGroup(data, out + i, (header[group/4] >> (group%4*2)) & 3);
+    }
+
+    return data;
+}
+
+/* Undoes the zigzag encoding and the delta of a channel in place. The size
+   is a multiple of the group size. */
+void decodeDeltas(UnsignedByte* const data, const std::size_t size, const UnsignedByte last) {
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i low = _mm_set1_epi8(0x7f);
+    __m128i previous = _mm_set1_epi8(char(last));
+    for(std::size_t i = 0; i != size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+
+        /* (v >> 1) ^ -(v & 1), there's no 8-bit shift so it's done on 16-bit
+           lanes and the bits from the neighbor masked away */
+        v = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(v, 1), low), _mm_sub_epi8(zero, _mm_and_si128(v, one)));
+
+        /* Inclusive prefix sum of all 16 bytes, offset by the last value of
+           the previous group */
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 1));
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 2));
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi8(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi8(v, previous);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), v);
+
+        /* Broadcast the last byte for the next group */
+        const __m128i high = _mm_unpackhi_epi8(v, v);
+        previous = _mm_shuffle_epi32(_mm_unpackhi_epi16(high, high), 0xff);
+    }
+    #else
+    UnsignedByte previous = last;
+    for(std::size_t i = 0; i != size; ++i) {
+        const UnsignedByte v = data[i];
+        previous += UnsignedByte((v >> 1) ^ -(v & 1));
+        data[i] = previous;
+    }
+    #endif
+}
+
+const UnsignedByte* decodeVertexBlock(const UnsignedByte* data, const UnsignedByte* const end, UnsignedByte* const out, const std::size_t count, const std::size_t stride, UnsignedByte* const last) {
+    UnsignedByte buffer[VertexBlockMaxSize];
+    const std::size_t alignedCount = (count + ByteGroupSize - 1) & ~(ByteGroupSize - 1);
+
+    for(std::size_t k = 0; k != stride; ++k) {
+        data = decodeBytes(data, end, buffer, alignedCount);
+        if(!data) return nullptr;
+
+        decodeDeltas(buffer, alignedCount, last[k]);
+        for(std::size_t i = 0; i != count; ++i)
+            out[i*stride + k] = buffer[i];
+        last[k] = buffer[count - 1];
+    }
+
+    return data;
+}
+
+/* Index codecs */
+constexpr UnsignedByte IndexHeader = 0xe0;
+constexpr UnsignedByte SequenceHeader = 0xd0;
+
+inline void writeIndex(char* const dst, const std::size_t i, const std::size_t stride, const UnsignedInt value) {
+    if(stride == 2) {
+        const UnsignedShort value16 = value;
+        std::memcpy(dst + i*2, &value16, 2);
+    } else std::memcpy(dst + i*4, &value, 4);
+}
+
+inline void writeTriangle(char* const dst, const std::size_t i, const std::size_t stride, const UnsignedInt a, const UnsignedInt b, const UnsignedInt c) {
+    writeIndex(dst, i + 0, stride, a);
+    writeIndex(dst, i + 1, stride, b);
+    writeIndex(dst, i + 2, stride, c);
+}
+
+/* Seven bits per byte, the highest bit marking a continuation */
+UnsignedInt decodeVByte(const UnsignedByte*& data) {
+    const UnsignedByte lead = *data++;
+    if(lead < 128) return lead;
+
+    UnsignedInt result = lead & 127;
+    UnsignedInt shift = 7;
+    for(std::size_t i = 0; i != 4; ++i) {
+        const UnsignedByte group = *data++;
+        result |= UnsignedInt(group & 127) << shift;
+        shift += 7;
+        if(group < 128) break;
+    }
+
+    return result;
+}
+
+/* Zigzag-encoded delta against the last free index */
+UnsignedInt decodeIndex(const UnsignedByte*& data, const UnsignedInt last) {
+    const UnsignedInt v = decodeVByte(data);
+    return last + ((v >> 1) ^ -(v & 1));
+}
+
+/* FIFOs of recently seen vertices and edges, reads wrap around */
+struct IndexFifos {
+    UnsignedInt vertices[16];
+    UnsignedInt edges[16][2];
+    std::size_t vertexOffset;
+    std::size_t edgeOffset;
+
+    void pushVertex(const UnsignedInt v, const bool condition = true) {
+        vertices[vertexOffset] = v;
+        vertexOffset = (vertexOffset + condition) & 15;
+    }
+
+    void pushEdge(const UnsignedInt a, const UnsignedInt b) {
+        edges[edgeOffset][0] = a;
+        edges[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    }
+};
+
+/* Exponent and mantissa to a float, a faster version of ldexp(m, e) */
+inline Float exponential(const Int m, const Int e) {
+    const UnsignedInt bits = UnsignedInt(e + 127) << 23;
+    Float scale;
+    std::memcpy(&scale, &bits, 4);
+    return scale*Float(m);
+}
+
+template<class T> void filterOctahedral(T* const data, const std::size_t count) {
+    const Float max = Float((1 << (sizeof(T)*8 - 1)) - 1);
+
+    for(std::size_t i = 0; i != count; ++i) {
+        /* The third component encodes 1.0, which allows reconstructing Z */
+        Float x = Float(data[i*4 + 0]);
+        Float y = Float(data[i*4 + 1]);
+        const Float z = Float(data[i*4 + 2]) - std::abs(x) - std::abs(y);
+
+        /* Unfold the lower hemisphere */
+        const Float t = z >= 0.0f ? 0.0f : z;
+        x += x >= 0.0f ? t : -t;
+        y += y >= 0.0f ? t : -t;
+
+        /* Normalize and round back to the original type. The fourth
+           component is left untouched. */
+        const Float scale = max/std::sqrt(x*x + y*y + z*z);
+        data[i*4 + 0] = T(Int(x*scale + (x >= 0.0f ? 0.5f : -0.5f)));
+        data[i*4 + 1] = T(Int(y*scale + (y >= 0.0f ? 0.5f : -0.5f)));
+        data[i*4 + 2] = T(Int(z*scale + (z >= 0.0f ? 0.5f : -0.5f)));
+    }
+}
+
+}
+
+std::size_t meshOptVertexBufferMinSize(const std::size_t count, const std::size_t stride) {
+    /* The header byte and the tail, plus for each byte of the vertex in
+       every block a header with two bits per group. The groups themselves
+       can be empty if all deltas in them are zero. */
+    const std::size_t blockSize = vertexBlockSize(stride);
+    const std::size_t fullBlockGroupHeaderSize = (blockSize/ByteGroupSize + 3)/4;
+    const std::size_t lastBlockCount = count%blockSize;
+    const std::size_t lastBlockGroupHeaderSize = ((lastBlockCount + ByteGroupSize - 1)/ByteGroupSize + 3)/4;
+    return 1 + std::max(TailMaxSize, stride) +
+        (count/blockSize*fullBlockGroupHeaderSize + lastBlockGroupHeaderSize)*stride;
+}
+
+std::size_t meshOptIndexBufferMinSize(const std::size_t count) {
+    /* The header, one code byte per triangle and a 16-byte table of
+       auxiliary codes at the end */
+    return 1 + count/3 + 16;
+}
+
+std::size_t meshOptIndexSequenceMinSize(const std::size_t count) {
+    /* The header, one byte per index and a 4-byte tail */
+    return 1 + count + 4;
+}
+
+bool meshOptDecodeVertexBuffer(char* const dst, const std::size_t count, const std::size_t stride, const Containers::ArrayView<const char> src) {
+    CORRADE_INTERNAL_ASSERT(stride && stride <= 256 && stride % 4 == 0);
+
+    const UnsignedByte* data = reinterpret_cast<const UnsignedByte*>(src.data());
+    const UnsignedByte* const end = data + src.size();
+    if(src.size() < meshOptVertexBufferMinSize(count, stride) || *data++ != VertexHeader) return false;
+
+    /* The tail stores the value the first vertex is delta-encoded against */
+    UnsignedByte last[256];
+    std::memcpy(last, end - stride, stride);
+
+    const std::size_t blockSize = vertexBlockSize(stride);
+    for(std::size_t offset = 0; offset < count; offset += blockSize) {
+        data = decodeVertexBlock(data, end, reinterpret_cast<UnsignedByte*>(dst) + offset*stride, std::min(blockSize, count - offset), stride, last);
+        if(!data) return false;
+    }
+
+    return std::size_t(end - data) == std::max(TailMaxSize, stride);
+}
+
+bool meshOptDecodeIndexBuffer(char* const dst, const std::size_t count, const std::size_t stride, const Containers::ArrayView<const char> src) {
+    CORRADE_INTERNAL_ASSERT(count % 3 == 0 && (stride == 2 || stride == 4));
+
+    if(src.size() < meshOptIndexBufferMinSize(count)) return false;
+    const UnsignedByte* const begin = reinterpret_cast<const UnsignedByte*>(src.data());
+    if((begin[0] & 0xf0) != IndexHeader) return false;
+    const UnsignedInt version = begin[0] & 0x0f;
+    if(version > 1) return false;
+
+    IndexFifos fifos;
+    std::fill_n(fifos.vertices, 16, ~UnsignedInt{});
+    std::fill_n(&fifos.edges[0][0], 32, ~UnsignedInt{});
+    fifos.vertexOffset = fifos.edgeOffset = 0;
+
+    UnsignedInt next = 0, last = 0;
+    /* Version 1 uses codes 13 and 14 for free indices differing by one from
+       the last one */
+    const UnsignedInt fecMax = version >= 1 ? 13 : 15;
+
+    const UnsignedByte* code = begin + 1;
+    const UnsignedByte* data = code + count/3;
+    const UnsignedByte* const dataSafeEnd = begin + src.size() - 16;
+    const UnsignedByte* const codeAuxTable = dataSafeEnd;
+
+    for(std::size_t i = 0; i != count; i += 3) {
+        /* A triangle reads at most 16 bytes of data, which are guaranteed to
+           be there thanks to the table at the end */
+        if(data > dataSafeEnd) return false;
+
+        const UnsignedByte codeTri = *code++;
+
+        /* Edge from the FIFO and a third vertex that's either new, from the
+           FIFO or a free index */
+        if(codeTri < 0xf0) {
+            const std::size_t fe = codeTri >> 4;
+            const UnsignedInt a = fifos.edges[(fifos.edgeOffset - 1 - fe) & 15][0];
+            const UnsignedInt b = fifos.edges[(fifos.edgeOffset - 1 - fe) & 15][1];
+            const UnsignedInt fec = codeTri & 15;
+
+            UnsignedInt c;
+            if(fec < fecMax) {
+                c = fec == 0 ? next++ : fifos.vertices[(fifos.vertexOffset - 1 - fec) & 15];
+                fifos.pushVertex(c, fec == 0);
+            } else {
+                /* 13 and 14 are decoded as -1 and +1 */
+                last = c = fec != 15 ? last + (Int(fec) - Int(fec ^ 3)) : decodeIndex(data, last);
+                fifos.pushVertex(c);
+            }
+
+            writeTriangle(dst, i, stride, a, b, c);
+            fifos.pushEdge(c, b);
+            fifos.pushEdge(a, c);
+
+        /* Three vertices, the first one new and the other two described by
+           an entry in the table of auxiliary codes */
+        } else if(codeTri < 0xfe) {
+            const UnsignedByte codeAux = codeAuxTable[codeTri & 15];
+            const UnsignedInt feb = codeAux >> 4;
+            const UnsignedInt fec = codeAux & 15;
+
+            const UnsignedInt a = next++;
+            const UnsignedInt b = feb == 0 ? next++ : fifos.vertices[(fifos.vertexOffset - feb) & 15];
+            const UnsignedInt c = fec == 0 ? next++ : fifos.vertices[(fifos.vertexOffset - fec) & 15];
+
+            writeTriangle(dst, i, stride, a, b, c);
+            fifos.pushVertex(a);
+            fifos.pushVertex(b, feb == 0);
+            fifos.pushVertex(c, fec == 0);
+            fifos.pushEdge(b, a);
+            fifos.pushEdge(c, b);
+            fifos.pushEdge(a, c);
+
+        /* Three vertices described by a full auxiliary code byte, any of them
+           can be a free index */
+        } else {
+            const UnsignedByte codeAux = *data++;
+            const UnsignedInt fea = codeTri == 0xfe ? 0 : 15;
+            const UnsignedInt feb = codeAux >> 4;
+            const UnsignedInt fec = codeAux & 15;
+
+            /* Zero is never put into the table, it means a reset */
+            if(codeAux == 0) next = 0;
+
+            UnsignedInt a = fea == 0 ? next++ : 0;
+            UnsignedInt b = feb == 0 ? next++ : fifos.vertices[(fifos.vertexOffset - feb) & 15];
+            UnsignedInt c = fec == 0 ? next++ : fifos.vertices[(fifos.vertexOffset - fec) & 15];
+            if(fea == 15) last = a = decodeIndex(data, last);
+            if(feb == 15) last = b = decodeIndex(data, last);
+            if(fec == 15) last = c = decodeIndex(data, last);
+
+            writeTriangle(dst, i, stride, a, b, c);
+            fifos.pushVertex(a);
+            fifos.pushVertex(b, feb == 0 || feb == 15);
+            fifos.pushVertex(c, fec == 0 || fec == 15);
+            fifos.pushEdge(b, a);
+            fifos.pushEdge(c, b);
+            fifos.pushEdge(a, c);
+        }
+    }
+
+    /* All data should be consumed, ending right at the table */
+    return data == dataSafeEnd;
+}
+
+bool meshOptDecodeIndexSequence(char* const dst, const std::size_t count, const std::size_t stride, const Containers::ArrayView<const char> src) {
+    CORRADE_INTERNAL_ASSERT(stride == 2 || stride == 4);
+
+    if(src.size() < meshOptIndexSequenceMinSize(count)) return false;
+    const UnsignedByte* const begin = reinterpret_cast<const UnsignedByte*>(src.data());
+    if((begin[0] & 0xf0) != SequenceHeader) return false;
+    if((begin[0] & 0x0f) > 1) return false;
+
+    const UnsignedByte* data = begin + 1;
+    const UnsignedByte* const dataSafeEnd = begin + src.size() - 4;
+
+    /* Each index is a delta against one of two baselines, selected by the
+       lowest bit */
+    UnsignedInt last[2]{};
+    for(std::size_t i = 0; i != count; ++i) {
+        /* An index reads at most 5 bytes, the tail makes that safe */
+        if(data >= dataSafeEnd) return false;
+
+        UnsignedInt v = decodeVByte(data);
+        const UnsignedInt baseline = v & 1;
+        v >>= 1;
+        last[baseline] += (v >> 1) ^ -(v & 1);
+        writeIndex(dst, i, stride, last[baseline]);
+    }
+
+    return data == dataSafeEnd;
+}
+
+void meshOptFilterOctahedral(char* const data, const std::size_t count, const std::size_t stride) {
+    if(stride == 4) filterOctahedral(reinterpret_cast<Byte*>(data), count);
+    else if(stride == 8) filterOctahedral(reinterpret_cast<Short*>(data), count);
+    else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+void meshOptFilterQuaternion(char* const data, const std::size_t count, const std::size_t stride) {
+    CORRADE_INTERNAL_ASSERT(stride == 8);
+    static_cast<void>(stride);
+
+    Short* const q = reinterpret_cast<Short*>(data);
+    const Float scale = 1.0f/std::sqrt(2.0f);
+    for(std::size_t i = 0; i != count; ++i) {
+        /* The fourth component stores the index of the omitted (largest)
+           component in the lowest two bits and the quantization scale in the
+           rest */
+        const Int indexAndScale = q[i*4 + 3];
+        const Float s = scale/Float(indexAndScale | 3);
+
+        const Float x = Float(q[i*4 + 0])*s;
+        const Float y = Float(q[i*4 + 1])*s;
+        const Float z = Float(q[i*4 + 2])*s;
+
+        /* Reconstruct the omitted component, clamped to avoid NaNs due to
+           precision errors */
+        const Float ww = 1.0f - x*x - y*y - z*z;
+        const Float w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+        const std::size_t omitted = indexAndScale & 3;
+        q[i*4 + ((omitted + 1) & 3)] = Short(Int(x*32767.0f + (x >= 0.0f ? 0.5f : -0.5f)));
+        q[i*4 + ((omitted + 2) & 3)] = Short(Int(y*32767.0f + (y >= 0.0f ? 0.5f : -0.5f)));
+        q[i*4 + ((omitted + 3) & 3)] = Short(Int(z*32767.0f + (z >= 0.0f ? 0.5f : -0.5f)));
+        q[i*4 + ((omitted + 0) & 3)] = Short(Int(w*32767.0f + 0.5f));
+    }
+}
+
+void meshOptFilterExponential(char* const data, const std::size_t count, const std::size_t stride) {
+    CORRADE_INTERNAL_ASSERT(stride % 4 == 0);
+
+    /* Each 32-bit value is a 24-bit signed mantissa and an 8-bit signed
+       exponent, which gets converted to a float in place */
+    UnsignedInt* const values = reinterpret_cast<UnsignedInt*>(data);
+    const std::size_t size = count*stride/4;
+    std::size_t i = 0;
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+    const __m128i bias = _mm_set1_epi32(127);
+    for(; i + 4 <= size; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        const __m128i m = _mm_srai_epi32(_mm_slli_epi32(v, 8), 8);
+        const __m128i e = _mm_srai_epi32(v, 24);
+        const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(e, bias), 23));
+        _mm_storeu_ps(reinterpret_cast<Float*>(values + i), _mm_mul_ps(scale, _mm_cvtepi32_ps(m)));
+    }
+    #endif
+    for(; i != size; ++i) {
+        const Int v = Int(values[i]);
+        const Float value = exponential(Int(UnsignedInt(v) << 8) >> 8, v >> 24);
+        std::memcpy(values + i, &value, 4);
+    }
+}
+
+}}}
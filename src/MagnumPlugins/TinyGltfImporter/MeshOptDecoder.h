@@ -0,0 +1,72 @@
+#ifndef Magnum_Trade_Implementation_MeshOptDecoder_h
+#define Magnum_Trade_Implementation_MeshOptDecoder_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/Magnum.h>
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* Decoders for the vertex and index codecs and the filters of the
+   EXT_meshopt_compression glTF extension, compatible with the bitstream
+   produced by meshoptimizer:
+   https://github.com/KhronosGroup/glTF/tree/master/extensions/2.0/Vendor/EXT_meshopt_compression
+
+   The output has to be large enough for `count*stride` bytes. The decoders
+   return false if the input is malformed, in which case the output contents
+   are unspecified. */
+
+/* Smallest possible size of the encoded data for given element count and
+   stride in each mode. Used to reject counts that the data can't possibly
+   encode before allocating the output. */
+std::size_t meshOptVertexBufferMinSize(std::size_t count, std::size_t stride);
+std::size_t meshOptIndexBufferMinSize(std::size_t count);
+std::size_t meshOptIndexSequenceMinSize(std::size_t count);
+
+/* ATTRIBUTES mode, stride has to be a multiple of 4 and at most 256 */
+bool meshOptDecodeVertexBuffer(char* dst, std::size_t count, std::size_t stride, Containers::ArrayView<const char> src);
+
+/* TRIANGLES mode, count has to be divisible by 3, stride is 2 or 4 */
+bool meshOptDecodeIndexBuffer(char* dst, std::size_t count, std::size_t stride, Containers::ArrayView<const char> src);
+
+/* INDICES mode, stride is 2 or 4 */
+bool meshOptDecodeIndexSequence(char* dst, std::size_t count, std::size_t stride, Containers::ArrayView<const char> src);
+
+/* OCTAHEDRAL filter, applied in place. Stride is 4 for four-component bytes
+   and 8 for four-component shorts. */
+void meshOptFilterOctahedral(char* data, std::size_t count, std::size_t stride);
+
+/* QUATERNION filter, applied in place. Stride is 8 for four-component
+   shorts. */
+void meshOptFilterQuaternion(char* data, std::size_t count, std::size_t stride);
+
+/* EXPONENTIAL filter, applied in place. Stride has to be a multiple of 4. */
+void meshOptFilterExponential(char* data, std::size_t count, std::size_t stride);
+
+}}}
+
+#endif
@@ -0,0 +1,210 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Trade/AbstractImporter.h>
+
+#define TINYGLTF_IMPLEMENTATION
+/* Opt out of everything except JSON parsing, same as the importer did before
+   switching to its own parser */
+#define TINYGLTF_NO_STB_IMAGE
+#define TINYGLTF_NO_STB_IMAGE_WRITE
+#define TINYGLTF_NO_EXTERNAL_IMAGE
+
+#ifdef CORRADE_TARGET_WINDOWS
+/* Tinygltf includes some windows headers, avoid including more than ncessary
+   to speed up compilation. WIN32_LEAN_AND_MEAN and NOMINMAX is already defined
+   by CMake. */
+#define VC_EXTRALEAN
+#endif
+
+/* Include like this instead of "MagnumExternal/TinyGltf/tiny_gltf.h" so we can
+   include it as a system header and suppress warnings */
+#include "tiny_gltf.h"
+#ifdef CORRADE_TARGET_WINDOWS
+#undef near
+#undef far
+#endif
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct TinyGltfImporterBenchmark: TestSuite::Tester {
+    explicit TinyGltfImporterBenchmark();
+
+    void openTinyGltf();
+    void openTinyGltfImporter();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+
+    /* Data for the last instance, to avoid generating them again for the
+       other benchmark */
+    std::size_t _sceneInstance = ~std::size_t{};
+    std::string _scene;
+};
+
+namespace {
+
+constexpr struct {
+    const char* name;
+    std::size_t nodeCount;
+    bool indented;
+} SceneData[]{
+    {"10k nodes", 10000, false},
+    {"100k nodes", 100000, false},
+    {"100k nodes, indented", 100000, true}
+};
+
+/* A scene with given count of nodes in a tree hierarchy, each with a TRS
+   transformation and an own mesh. Each mesh references three accessors with
+   bounds, so there's 3x more accessors than nodes. The buffer is a small
+   zero-filled data URI so tinygltf doesn't need to access any files. */
+std::string scene(const std::size_t nodeCount, const bool indented) {
+    const char* const nl = indented ? "\n" : "";
+    const char* const indent = indented ? "        " : "";
+
+    std::string out;
+    out.reserve(nodeCount*1024);
+    out += "{"; out += nl;
+    out += "  \"asset\": {\"version\": \"2.0\", \"generator\": \"TinyGltfImporterBenchmark\"},"; out += nl;
+    out += "  \"scene\": 0,"; out += nl;
+    out += "  \"scenes\": [{\"nodes\": [0]}],"; out += nl;
+
+    out += "  \"nodes\": ["; out += nl;
+    for(std::size_t i = 0; i != nodeCount; ++i) {
+        out += indent;
+        out += "{\"name\": \"Node " + std::to_string(i) + "\", \"mesh\": " + std::to_string(i);
+        out += ", \"translation\": [" + std::to_string(i%1000) + ".5, -" + std::to_string(i/1000) + ".25, 0.125]";
+        out += ", \"rotation\": [0.0, 0.7071068, 0.0, 0.7071068]";
+        out += ", \"scale\": [1.5, 1.5, 1.5]";
+        /* A tree with ten children per node, the first node is the root */
+        if(i*10 + 1 < nodeCount) {
+            out += ", \"children\": [";
+            for(std::size_t j = i*10 + 1, end = Math::min(i*10 + 11, nodeCount); j != end; ++j) {
+                if(j != i*10 + 1) out += ", ";
+                out += std::to_string(j);
+            }
+            out += "]";
+        }
+        out += i + 1 == nodeCount ? "}" : "},";
+        out += nl;
+    }
+    out += "  ],"; out += nl;
+
+    out += "  \"meshes\": ["; out += nl;
+    for(std::size_t i = 0; i != nodeCount; ++i) {
+        out += indent;
+        out += "{\"name\": \"Mesh " + std::to_string(i) + "\", \"primitives\": [{\"attributes\": {\"POSITION\": " + std::to_string(i*3) + ", \"NORMAL\": " + std::to_string(i*3 + 1) + "}, \"indices\": " + std::to_string(i*3 + 2) + ", \"material\": 0}]}";
+        out += i + 1 == nodeCount ? "" : ",";
+        out += nl;
+    }
+    out += "  ],"; out += nl;
+
+    out += "  \"accessors\": ["; out += nl;
+    for(std::size_t i = 0; i != nodeCount; ++i) {
+        out += indent;
+        out += "{\"bufferView\": 0, \"byteOffset\": 0, \"componentType\": 5126, \"count\": 24, \"type\": \"VEC3\", \"min\": [-1.0, -1.0, -1.0], \"max\": [1.0, 1.0, 1.0]},"; out += nl;
+        out += indent;
+        out += "{\"bufferView\": 0, \"byteOffset\": 288, \"componentType\": 5126, \"count\": 24, \"type\": \"VEC3\"},"; out += nl;
+        out += indent;
+        out += "{\"bufferView\": 1, \"componentType\": 5123, \"count\": 36, \"type\": \"SCALAR\"}";
+        out += i + 1 == nodeCount ? "" : ",";
+        out += nl;
+    }
+    out += "  ],"; out += nl;
+
+    out += "  \"bufferViews\": ["; out += nl;
+    out += "    {\"buffer\": 0, \"byteLength\": 576, \"target\": 34962},"; out += nl;
+    out += "    {\"buffer\": 0, \"byteOffset\": 576, \"byteLength\": 72, \"target\": 34963}"; out += nl;
+    out += "  ],"; out += nl;
+    out += "  \"buffers\": [{\"uri\": \"data:application/octet-stream;base64," + std::string(648/3*4, 'A') + "\", \"byteLength\": 648}],"; out += nl;
+    out += "  \"materials\": [{\"name\": \"Material\", \"pbrMetallicRoughness\": {\"baseColorFactor\": [0.8, 0.2, 0.4, 1.0], \"metallicFactor\": 0.0}}]"; out += nl;
+    out += "}"; out += nl;
+    return out;
+}
+
+}
+
+TinyGltfImporterBenchmark::TinyGltfImporterBenchmark() {
+    /* The original tinygltf JSON parser compared to the importer */
+    addInstancedBenchmarks({&TinyGltfImporterBenchmark::openTinyGltf,
+                            &TinyGltfImporterBenchmark::openTinyGltfImporter}, 5,
+        Containers::arraySize(SceneData));
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef TINYGLTFIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT(_manager.load(TINYGLTFIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void TinyGltfImporterBenchmark::openTinyGltf() {
+    auto&& data = SceneData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(_sceneInstance != testCaseInstanceId()) {
+        _scene = scene(data.nodeCount, data.indented);
+        _sceneInstance = testCaseInstanceId();
+    }
+
+    tinygltf::Model model;
+    bool loaded = false;
+    CORRADE_BENCHMARK(1) {
+        tinygltf::TinyGLTF loader;
+        std::string err;
+        model = tinygltf::Model{};
+        loaded = loader.LoadASCIIFromString(&model, &err, nullptr, _scene.data(), _scene.size(), {}, tinygltf::SectionCheck::NO_REQUIRE);
+    }
+
+    CORRADE_VERIFY(loaded);
+    CORRADE_COMPARE(model.nodes.size(), data.nodeCount);
+    CORRADE_COMPARE(model.accessors.size(), data.nodeCount*3);
+}
+
+void TinyGltfImporterBenchmark::openTinyGltfImporter() {
+    auto&& data = SceneData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(_sceneInstance != testCaseInstanceId()) {
+        _scene = scene(data.nodeCount, data.indented);
+        _sceneInstance = testCaseInstanceId();
+    }
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    bool opened = false;
+    CORRADE_BENCHMARK(1)
+        opened = importer->openData({_scene.data(), _scene.size()});
+
+    CORRADE_VERIFY(opened);
+    CORRADE_COMPARE(importer->object3DCount(), data.nodeCount);
+    CORRADE_COMPARE(importer->mesh3DCount(), data.nodeCount);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::TinyGltfImporterBenchmark)
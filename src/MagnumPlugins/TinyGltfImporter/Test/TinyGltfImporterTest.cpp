@@ -26,11 +26,13 @@
 */
 
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/String.h>
 #include <Magnum/Array.h>
 #include <Magnum/Mesh.h>
 #include <Magnum/PixelFormat.h>
@@ -49,6 +51,8 @@
 #include <Magnum/Trade/TextureData.h>
 #include <Magnum/Sampler.h>
 
+#include "MagnumPlugins/TinyGltfImporter/TinyGltfImporter.h"
+
 #include "configure.h"
 
 namespace Magnum { namespace Trade { namespace Test {
@@ -58,6 +62,7 @@ struct TinyGltfImporterTest: TestSuite::Tester {
 
     void open();
     void openError();
+    void openDeeplyNestedExtras();
 
     void animation();
     void animationWrongTimeType();
@@ -95,6 +100,21 @@ struct TinyGltfImporterTest: TestSuite::Tester {
     void meshUnknownAttribute();
     void meshPrimitives();
     void meshColors();
+    void meshInterleaved();
+    void meshIndexData();
+    void meshIndexDataNonIndexed();
+    void meshQuantized();
+    void meshQuantizedAttributeData();
+    void meshSparse();
+    void meshTextureCoordinateYFlipInShader();
+    void meshMeshOpt();
+    void meshMeshOptInvalid();
+    void meshMeshOptInvalidCount();
+    void meshOutOfBounds();
+    void meshBounds();
+    void meshBoundsMetadata();
+    void meshBoundsNoPositions();
+    void meshAttributeAccessorOutOfRange();
     void meshWithStride();
 
     void meshMultiplePrimitives();
@@ -108,9 +128,13 @@ struct TinyGltfImporterTest: TestSuite::Tester {
     void textureDefaultSampler();
 
     void image();
+    void imagePrefetch();
+    void imagePrefetchInvalidDataUri();
+    void imageCache();
 
     void fileCallbackBuffer();
     void fileCallbackBufferNotFound();
+    void fileCallbackBufferPermanent();
     void fileCallbackImage();
     void fileCallbackImageNotFound();
 
@@ -127,7 +151,53 @@ constexpr struct {
     const char* shortDataError;
 } OpenErrorData[]{
     {"ascii", ".gltf", {"?", 1}, "JSON string too short.\n"},
-    {"binary", ".glb", {"glTF?", 5}, "Too short data size for glTF Binary.\n"}
+    {"binary", ".glb", {"glTF?", 5}, "Too short data size for glTF Binary.\n"},
+    {"binary invalid JSON chunk", ".glb", {"glTF\x02\0\0\0\x18\0\0\0\x04\0\0\0BIN\0", 20}, "Invalid glTF binary.\n"},
+    {"invalid JSON", ".gltf", {"{\"asset\": }", 11}, "JSON error at line 1, column 11: expected a value\n"},
+    {"root not an object", ".gltf", {"[1, 2]", 6}, "root element is not a JSON object\n"},
+    {"missing required property", ".gltf", {"{\"accessors\": [{}]}", 19}, "missing or invalid componentType property in accessor 0\n"},
+    {"fractional integer", ".gltf", {"{\"accessors\": [{\"componentType\": 5126.5}]}", 42}, "missing or invalid componentType property in accessor 0\n"},
+    {"negative unsigned integer", ".gltf", {"{\"accessors\": [{\"componentType\": 5126, \"count\": -1}]}", 53}, "missing or invalid count property in accessor 0\n"},
+    {"out of range integer", ".gltf", {"{\"accessors\": [{\"componentType\": 5126, \"count\": 1e30}]}", 55}, "missing or invalid count property in accessor 0\n"}
+};
+
+constexpr struct {
+    const char* name;
+    const char* bufferView;
+    const char* message;
+} MeshOptInvalidCountData[]{
+    {"count not matching the view",
+        R"({"buffer": 0, "byteLength": 36, "extensions": {"EXT_meshopt_compression": {"buffer": 0, "byteLength": 12, "byteStride": 256, "count": 2147483647, "mode": "ATTRIBUTES"}}})",
+        "buffer view 0 has 36 bytes but EXT_meshopt_compression has 2147483647 elements with stride 256"},
+    {"attributes too short",
+        R"({"buffer": 0, "byteLength": 4294967296, "extensions": {"EXT_meshopt_compression": {"buffer": 0, "byteLength": 12, "byteStride": 256, "count": 16777216, "mode": "ATTRIBUTES"}}})",
+        "compressed data of buffer view 0 are too short for 16777216 elements, expected at least 134217985 bytes but got 12"},
+    {"triangles too short",
+        R"({"buffer": 0, "byteLength": 6000, "extensions": {"EXT_meshopt_compression": {"buffer": 0, "byteLength": 12, "byteStride": 2, "count": 3000, "mode": "TRIANGLES"}}})",
+        "compressed data of buffer view 0 are too short for 3000 elements, expected at least 1017 bytes but got 12"},
+    {"indices too short",
+        R"({"buffer": 0, "byteLength": 4000, "extensions": {"EXT_meshopt_compression": {"buffer": 0, "byteLength": 12, "byteStride": 4, "count": 1000, "mode": "INDICES"}}})",
+        "compressed data of buffer view 0 are too short for 1000 elements, expected at least 1005 bytes but got 12"}
+};
+
+constexpr struct {
+    const char* name;
+    const char* bufferView;
+    const char* accessor;
+    const char* message;
+} OutOfBoundsData[]{
+    {"buffer view offset overflow",
+        R"({"buffer": 0, "byteOffset": 18446744073709549568, "byteLength": 2048})",
+        R"({"bufferView": 0, "componentType": 5126, "count": 1, "type": "VEC3"})",
+        "buffer view 0 is out of bounds"},
+    {"accessor count overflow",
+        R"({"buffer": 0, "byteLength": 12})",
+        R"({"bufferView": 0, "componentType": 5126, "count": 4611686018427387904, "type": "VEC3"})",
+        "accessor 0 is out of bounds"},
+    {"accessor without a view too large",
+        R"({"buffer": 0, "byteLength": 12})",
+        R"({"componentType": 5126, "count": 4611686018427387904, "type": "VEC3"})",
+        "accessor 0 is too large"}
 };
 
 constexpr struct {
@@ -173,6 +243,8 @@ TinyGltfImporterTest::TinyGltfImporterTest() {
     addInstancedTests({&TinyGltfImporterTest::openError},
                       Containers::arraySize(OpenErrorData));
 
+    addTests({&TinyGltfImporterTest::openDeeplyNestedExtras});
+
     addInstancedTests({&TinyGltfImporterTest::animation},
                       Containers::arraySize(MultiFileData));
 
@@ -213,9 +285,29 @@ TinyGltfImporterTest::TinyGltfImporterTest() {
                        &TinyGltfImporterTest::meshIndexed,
                        &TinyGltfImporterTest::meshUnknownAttribute,
                        &TinyGltfImporterTest::meshPrimitives,
-                       &TinyGltfImporterTest::meshColors},
+                       &TinyGltfImporterTest::meshColors,
+                       &TinyGltfImporterTest::meshInterleaved,
+                       &TinyGltfImporterTest::meshIndexData,
+                       &TinyGltfImporterTest::meshQuantized,
+                       &TinyGltfImporterTest::meshQuantizedAttributeData,
+                       &TinyGltfImporterTest::meshSparse,
+                       &TinyGltfImporterTest::meshTextureCoordinateYFlipInShader,
+                       &TinyGltfImporterTest::meshBounds},
                       Containers::arraySize(MultiFileData));
 
+    addTests({&TinyGltfImporterTest::meshIndexDataNonIndexed,
+              &TinyGltfImporterTest::meshMeshOpt,
+              &TinyGltfImporterTest::meshMeshOptInvalid,
+              &TinyGltfImporterTest::meshBoundsMetadata,
+              &TinyGltfImporterTest::meshBoundsNoPositions,
+              &TinyGltfImporterTest::meshAttributeAccessorOutOfRange});
+
+    addInstancedTests({&TinyGltfImporterTest::meshMeshOptInvalidCount},
+                      Containers::arraySize(MeshOptInvalidCountData));
+
+    addInstancedTests({&TinyGltfImporterTest::meshOutOfBounds},
+                      Containers::arraySize(OutOfBoundsData));
+
     /* There are no external data for this one at the moment */
     addInstancedTests({&TinyGltfImporterTest::meshWithStride},
                       Containers::arraySize(SingleFileData));
@@ -231,11 +323,16 @@ TinyGltfImporterTest::TinyGltfImporterTest() {
                        &TinyGltfImporterTest::textureDefaultSampler},
                       Containers::arraySize(SingleFileData));
 
-    addInstancedTests({&TinyGltfImporterTest::image},
+    addInstancedTests({&TinyGltfImporterTest::image,
+                       &TinyGltfImporterTest::imagePrefetch},
                       Containers::arraySize(ImageData));
 
+    addTests({&TinyGltfImporterTest::imagePrefetchInvalidDataUri,
+              &TinyGltfImporterTest::imageCache});
+
     addInstancedTests({&TinyGltfImporterTest::fileCallbackBuffer,
                        &TinyGltfImporterTest::fileCallbackBufferNotFound,
+                       &TinyGltfImporterTest::fileCallbackBufferPermanent,
                        &TinyGltfImporterTest::fileCallbackImage,
                        &TinyGltfImporterTest::fileCallbackImageNotFound},
                       Containers::arraySize(SingleFileData));
@@ -284,6 +381,16 @@ void TinyGltfImporterTest::openError() {
     CORRADE_COMPARE(out.str(), "Trade::TinyGltfImporter::openData(): error opening file: " + std::string{data.shortDataError});
 }
 
+void TinyGltfImporterTest::openDeeplyNestedExtras() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+
+    /* The nesting is deep enough to overflow the stack if the extras were
+       converted recursively without a limit */
+    const std::string gltf = R"({"asset": {"version": "2.0", "extras": )" +
+        std::string(100000, '[') + "1" + std::string(100000, ']') + "}}";
+    CORRADE_VERIFY(importer->openData({gltf.data(), gltf.size()}));
+}
+
 void TinyGltfImporterTest::animation() {
     auto&& data = MultiFileData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -1464,26 +1571,524 @@ void TinyGltfImporterTest::meshColors() {
     }), TestSuite::Compare::Container);
 }
 
-void TinyGltfImporterTest::meshWithStride() {
-    auto&& data = SingleFileData[testCaseInstanceId()];
+void TinyGltfImporterTest::meshInterleaved() {
+    auto&& data = MultiFileData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
 
     std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
     CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
-        "mesh-with-stride" + std::string{data.suffix})));
+        "mesh-interleaved" + std::string{data.suffix})));
+
+    CORRADE_COMPARE(importer->mesh3DCount(), 1);
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE_AS(mesh->indices(), (std::vector<UnsignedInt>{
+        0, 2, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->positions(0), (std::vector<Vector3>{
+        {1.5f, -1.0f, -0.5f},
+        {-0.5f, 2.5f, 0.75f},
+        {-2.0f, 1.0f, 0.3f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->normalArrayCount(), 1);
+    CORRADE_COMPARE_AS(mesh->normals(0), (std::vector<Vector3>{
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->textureCoords2DArrayCount(), 1);
+    CORRADE_COMPARE_AS(mesh->textureCoords2D(0), (std::vector<Vector2>{
+        {0.25f, 0.25f},
+        {0.5f, 0.5f},
+        {1.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->colorArrayCount(), 1);
+    CORRADE_COMPARE_AS(mesh->colors(0), (std::vector<Color4>{
+        {0.1f, 0.2f, 0.3f, 1.0f},
+        {0.4f, 0.5f, 0.6f, 1.0f},
+        {0.7f, 0.8f, 0.9f, 1.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void TinyGltfImporterTest::meshIndexData() {
+    auto&& data = MultiFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-primitives" + std::string{data.suffix})));
+
+    /* The indices are returned in the type they're stored in */
+    {
+        MeshIndexType type{};
+        Containers::Optional<Containers::ArrayView<const char>> indices = static_cast<TinyGltfImporter&>(*importer).indexData(0, type);
+        CORRADE_VERIFY(indices);
+        CORRADE_COMPARE(type, MeshIndexType::UnsignedByte);
+        CORRADE_COMPARE(std::vector<UnsignedInt>(reinterpret_cast<const UnsignedByte*>(indices->begin()), reinterpret_cast<const UnsignedByte*>(indices->end())),
+            (std::vector<UnsignedInt>{0, 2, 1}));
+    } {
+        MeshIndexType type{};
+        Containers::Optional<Containers::ArrayView<const char>> indices = static_cast<TinyGltfImporter&>(*importer).indexData(1, type);
+        CORRADE_VERIFY(indices);
+        CORRADE_COMPARE(type, MeshIndexType::UnsignedShort);
+        CORRADE_COMPARE(std::vector<UnsignedInt>(reinterpret_cast<const UnsignedShort*>(indices->begin()), reinterpret_cast<const UnsignedShort*>(indices->end())),
+            (std::vector<UnsignedInt>{0, 2, 1, 3}));
+    } {
+        MeshIndexType type{};
+        Containers::Optional<Containers::ArrayView<const char>> indices = static_cast<TinyGltfImporter&>(*importer).indexData(2, type);
+        CORRADE_VERIFY(indices);
+        CORRADE_COMPARE(type, MeshIndexType::UnsignedInt);
+        CORRADE_COMPARE(std::vector<UnsignedInt>(reinterpret_cast<const UnsignedInt*>(indices->begin()), reinterpret_cast<const UnsignedInt*>(indices->end())),
+            (std::vector<UnsignedInt>{0, 1}));
+    }
+}
+
+void TinyGltfImporterTest::meshIndexDataNonIndexed() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh.gltf")));
+
+    MeshIndexType type{};
+    Containers::Optional<Containers::ArrayView<const char>> indices = static_cast<TinyGltfImporter&>(*importer).indexData(0, type);
+    CORRADE_VERIFY(indices);
+    CORRADE_VERIFY(indices->empty());
+}
+
+void TinyGltfImporterTest::meshQuantized() {
+    auto&& data = MultiFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-quantized" + std::string{data.suffix})));
+
+    CORRADE_COMPARE(importer->mesh3DCount(), 1);
+
+    auto mesh = importer->mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!mesh->isIndexed());
+
+    /* Interleaved non-normalized shorts */
+    CORRADE_COMPARE_AS(mesh->positions(0), (std::vector<Vector3>{
+        {1.0f, 2.0f, 3.0f},
+        {-4.0f, 5.0f, -6.0f},
+        {100.0f, -200.0f, 300.0f},
+        {-32768.0f, 32767.0f, 0.0f},
+        {7.0f, 8.0f, 9.0f},
+        {10.0f, 11.0f, 12.0f}
+    }), TestSuite::Compare::Container);
+
+    /* Interleaved normalized bytes, -128 is clamped to -1 */
+    CORRADE_COMPARE(mesh->normalArrayCount(), 1);
+    CORRADE_COMPARE_AS(mesh->normals(0), (std::vector<Vector3>{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {-1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f}
+    }), TestSuite::Compare::Container);
+
+    /* Tightly packed normalized unsigned shorts, Y-flipped */
+    CORRADE_COMPARE(mesh->textureCoords2DArrayCount(), 1);
+    CORRADE_COMPARE_AS(mesh->textureCoords2D(0), (std::vector<Vector2>{
+        {0.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.2f, 1.0f},
+        {0.0f, 0.8f},
+        {1.0f, 0.0f},
+        {0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+
+    /* Tightly packed normalized unsigned bytes */
+    CORRADE_COMPARE(mesh->colorArrayCount(), 1);
+    CORRADE_COMPARE_AS(mesh->colors(0), (std::vector<Color4>{
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f, 1.0f},
+        {0.2f, 0.4f, 0.6f, 0.8f},
+        {1.0f, 1.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void TinyGltfImporterTest::meshQuantizedAttributeData() {
+    auto&& data = MultiFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-quantized" + std::string{data.suffix})));
+
+    auto& gltfImporter = static_cast<TinyGltfImporter&>(*importer);
+
+    /* Interleaved, the view ends right after the last element */
+    {
+        Containers::Optional<TinyGltfImporter::PackedAttribute> attribute = gltfImporter.attributeData(0, "POSITION");
+        CORRADE_VERIFY(attribute);
+        CORRADE_COMPARE(attribute->data.size(), 5*8 + 6);
+        CORRADE_COMPARE(attribute->stride, 8);
+        CORRADE_COMPARE(attribute->componentCount, 3);
+        CORRADE_COMPARE(attribute->componentType, 5122);
+        CORRADE_VERIFY(!attribute->normalized);
+        const Short* last = reinterpret_cast<const Short*>(attribute->data + 5*8);
+        CORRADE_COMPARE(last[0], 10);
+        CORRADE_COMPARE(last[1], 11);
+        CORRADE_COMPARE(last[2], 12);
+    } {
+        Containers::Optional<TinyGltfImporter::PackedAttribute> attribute = gltfImporter.attributeData(0, "TEXCOORD_0");
+        CORRADE_VERIFY(attribute);
+        CORRADE_COMPARE(attribute->data.size(), 6*4);
+        CORRADE_COMPARE(attribute->stride, 4);
+        CORRADE_COMPARE(attribute->componentCount, 2);
+        CORRADE_COMPARE(attribute->componentType, 5123);
+        CORRADE_VERIFY(attribute->normalized);
+        /* Not flipped */
+        CORRADE_COMPARE(reinterpret_cast<const UnsignedShort*>(attribute->data.data())[1], 65535);
+    }
 
     std::ostringstream out;
     Error redirectError{&out};
+    CORRADE_VERIFY(!gltfImporter.attributeData(0, "TEXCOORD_1"));
+    CORRADE_COMPARE(out.str(), "Trade::TinyGltfImporter::attributeData(): mesh 0 has no attribute TEXCOORD_1\n");
+}
 
-    /* First has a stride of 12 bytes (no interleaving), shouldn't fail */
-    CORRADE_VERIFY(importer->mesh3D(0));
+void TinyGltfImporterTest::meshSparse() {
+    auto&& data = MultiFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-sparse" + std::string{data.suffix})));
+
+    CORRADE_COMPARE(importer->mesh3DCount(), 3);
+
+    /* Interleaved base view with two of the values replaced */
+    {
+        auto mesh = importer->mesh3D(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE_AS(mesh->positions(0), (std::vector<Vector3>{
+            {1.0f, 2.0f, 3.0f},
+            {-4.0f, -5.0f, -6.0f},
+            {7.0f, 8.0f, 9.0f},
+            {-10.0f, -11.0f, -12.0f}
+        }), TestSuite::Compare::Container);
+
+    /* No base view, the rest is zero-filled */
+    } {
+        auto mesh = importer->mesh3D(1);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE_AS(mesh->positions(0), (std::vector<Vector3>{
+            {0.0f, 0.0f, 0.0f},
+            {0.0f, 0.0f, 0.0f},
+            {0.5f, 1.5f, 2.5f},
+            {0.0f, 0.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+    }
+
+    /* The packed data are the expanded copy, not the base view */
+    Containers::Optional<TinyGltfImporter::PackedAttribute> attribute = static_cast<TinyGltfImporter&>(*importer).attributeData(0, "POSITION");
+    CORRADE_VERIFY(attribute);
+    CORRADE_COMPARE(attribute->data.size(), 4*12);
+    CORRADE_COMPARE(attribute->stride, 12);
+    CORRADE_COMPARE(reinterpret_cast<const Float*>(attribute->data.data())[3], -4.0f);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(2));
+    CORRADE_COMPARE(out.str(), "Trade::TinyGltfImporter::mesh3D(): sparse index of accessor 2 is out of range\n");
+}
+
+void TinyGltfImporterTest::meshTextureCoordinateYFlipInShader() {
+    auto&& data = MultiFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    TinyGltfImporter& gltfImporter = static_cast<TinyGltfImporter&>(*importer);
+
+    /* Flipped during import by default */
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-interleaved" + std::string{data.suffix})));
+    CORRADE_VERIFY(!gltfImporter.needsTextureCoordinateYFlip(0));
+
+    importer->configuration().setValue("textureCoordinateYFlipInShader", true);
+    CORRADE_VERIFY(gltfImporter.needsTextureCoordinateYFlip(0));
+
+    /* Interleaved floats, imported as-is */
+    {
+        auto mesh = importer->mesh3D(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->textureCoords2DArrayCount(), 1);
+        CORRADE_COMPARE_AS(mesh->textureCoords2D(0), (std::vector<Vector2>{
+            {0.25f, 0.75f},
+            {0.5f, 0.5f},
+            {1.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+    }
+
+    /* Tightly packed normalized unsigned shorts, imported as-is */
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-quantized" + std::string{data.suffix})));
+    CORRADE_VERIFY(gltfImporter.needsTextureCoordinateYFlip(0));
+    {
+        auto mesh = importer->mesh3D(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->textureCoords2DArrayCount(), 1);
+        CORRADE_COMPARE_AS(mesh->textureCoords2D(0), (std::vector<Vector2>{
+            {0.0f, 1.0f},
+            {1.0f, 0.0f},
+            {0.2f, 0.0f},
+            {0.0f, 0.2f},
+            {1.0f, 1.0f},
+            {0.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+    }
+
+    /* Meshes without texture coordinates don't need any flip */
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-colors" + std::string{data.suffix})));
+    CORRADE_VERIFY(!gltfImporter.needsTextureCoordinateYFlip(0));
+}
+
+void TinyGltfImporterTest::meshMeshOpt() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-meshopt.gltf")));
 
-    /* Second has a stride of 24 bytes, should fail */
+    CORRADE_COMPARE(importer->mesh3DCount(), 3);
+
+    /* Vertex codec without a filter, octahedral-filtered normals and the
+       triangle index codec */
     {
-        CORRADE_EXPECT_FAIL("Tnterleaved buffer views are not supported.");
-        CORRADE_VERIFY(importer->mesh3D(1));
+        auto mesh = importer->mesh3D(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+        CORRADE_COMPARE_AS(mesh->positions(0), (std::vector<Vector3>{
+            {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+            {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.5f},
+            {2.0f, 0.0f, 0.0f}, {2.0f, 1.0f, 1.0f},
+            {3.0f, 0.0f, 0.0f}, {3.0f, 1.0f, 1.5f},
+            {4.0f, 0.0f, 0.0f}, {4.0f, 1.0f, 2.0f},
+            {5.0f, 0.0f, 0.0f}, {5.0f, 1.0f, 2.5f},
+            {6.0f, 0.0f, 0.0f}, {6.0f, 1.0f, 3.0f},
+            {7.0f, 0.0f, 0.0f}, {7.0f, 1.0f, 3.5f},
+            {8.0f, 0.0f, 0.0f}, {8.0f, 1.0f, 4.0f}
+        }), TestSuite::Compare::Container);
+
+        CORRADE_COMPARE(mesh->normalArrayCount(), 1);
+        CORRADE_COMPARE_AS(mesh->normals(0), (std::vector<Vector3>{
+            { 1.0f,  0.0f,  0.0f}, { 0.0f,  0.0f,  1.0f},
+            { 0.0f,  0.0f, -1.0f}, { 0.0f, -1.0f,  0.0f},
+            {-1.0f,  0.0f,  0.0f}, { 0.0f,  1.0f,  0.0f},
+            { 1.0f,  0.0f,  0.0f}, { 0.0f,  0.0f,  1.0f},
+            { 0.0f,  0.0f, -1.0f}, { 0.0f, -1.0f,  0.0f},
+            {-1.0f,  0.0f,  0.0f}, { 0.0f,  1.0f,  0.0f},
+            { 1.0f,  0.0f,  0.0f}, { 0.0f,  0.0f,  1.0f},
+            { 0.0f,  0.0f, -1.0f}, { 0.0f, -1.0f,  0.0f},
+            {-1.0f,  0.0f,  0.0f}, { 0.0f,  1.0f,  0.0f}
+        }), TestSuite::Compare::Container);
+
+        CORRADE_VERIFY(mesh->isIndexed());
+        CORRADE_COMPARE_AS(mesh->indices(), (std::vector<UnsignedInt>{
+             0,  1,  2,  2,  1,  3,
+             2,  3,  4,  4,  3,  5,
+             4,  5,  6,  6,  5,  7,
+             6,  7,  8,  8,  7,  9,
+             8,  9, 10, 10,  9, 11,
+            10, 11, 12, 12, 11, 13,
+            12, 13, 14, 14, 13, 15,
+            14, 15, 16, 16, 15, 17
+        }), TestSuite::Compare::Container);
+
+    /* Exponential filter and the index sequence codec */
+    } {
+        auto mesh = importer->mesh3D(1);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE_AS(mesh->positions(0), (std::vector<Vector3>{
+            {1.5f, -0.25f, 1024.0f},
+            {0.125f, 3.0f, -7.0f},
+            {-2.0f, 0.0f, 0.75f}
+        }), TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(mesh->indices(), (std::vector<UnsignedInt>{
+            0, 1, 2, 2, 1, 0
+        }), TestSuite::Compare::Container);
     }
-    CORRADE_COMPARE(out.str(), "Trade::TinyGltfImporter::mesh3D(): interleaved buffer views are not supported\n");
+
+    /* The decoded data are exposed directly */
+    MeshIndexType type;
+    Containers::Optional<Containers::ArrayView<const char>> indices = static_cast<TinyGltfImporter&>(*importer).indexData(0, type);
+    CORRADE_VERIFY(indices);
+    CORRADE_COMPARE(type, MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(indices->size(), 48*2);
+    CORRADE_COMPARE(reinterpret_cast<const UnsignedShort*>(indices->data())[47], 17);
+}
+
+void TinyGltfImporterTest::meshMeshOptInvalid() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-meshopt.gltf")));
+
+    /* The views are decoded only when needed, so the broken data don't affect
+       other meshes */
+    CORRADE_VERIFY(importer->mesh3D(1));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(2));
+    CORRADE_COMPARE(out.str(), "Trade::TinyGltfImporter::mesh3D(): cannot decode buffer view 5\n");
+}
+
+void TinyGltfImporterTest::meshMeshOptInvalidCount() {
+    auto&& data = MeshOptInvalidCountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+
+    /* The counts are checked before allocating the output, so the huge ones
+       fail cleanly instead of attempting to allocate gigabytes */
+    const std::string gltf = std::string{R"({
+        "asset": {"version": "2.0"},
+        "extensionsUsed": ["EXT_meshopt_compression"],
+        "buffers": [{"uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAA", "byteLength": 12}],
+        "bufferViews": [)"} + data.bufferView + R"(],
+        "accessors": [{"bufferView": 0, "componentType": 5126, "count": 1, "type": "VEC3"}],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0}}]}]
+    })";
+    CORRADE_VERIFY(importer->openData({gltf.data(), gltf.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), std::string{"Trade::TinyGltfImporter::mesh3D(): "} + data.message + "\n");
+}
+
+void TinyGltfImporterTest::meshOutOfBounds() {
+    auto&& data = OutOfBoundsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+
+    /* The offsets and counts wrap around to a small value when added or
+       multiplied, which would slip past a naive bounds check */
+    const std::string gltf = std::string{R"({
+        "asset": {"version": "2.0"},
+        "buffers": [{"uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAA", "byteLength": 12}],
+        "bufferViews": [)"} + data.bufferView + R"(],
+        "accessors": [)" + data.accessor + R"(],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0}}]}]
+    })";
+    CORRADE_VERIFY(importer->openData({gltf.data(), gltf.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), std::string{"Trade::TinyGltfImporter::mesh3D(): "} + data.message + "\n");
+}
+
+void TinyGltfImporterTest::meshBounds() {
+    auto&& data = MultiFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-quantized" + std::string{data.suffix})));
+
+    /* The file has no min/max, so the bounds are calculated from the
+       interleaved non-normalized shorts */
+    auto& gltfImporter = static_cast<TinyGltfImporter&>(*importer);
+    const Containers::Optional<Range3D> bounds = gltfImporter.meshBounds(0);
+    CORRADE_VERIFY(bounds);
+    CORRADE_COMPARE(*bounds, (Range3D{{-32768.0f, -200.0f, -6.0f}, {100.0f, 32767.0f, 300.0f}}));
+}
+
+void TinyGltfImporterTest::meshBoundsMetadata() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+
+    /* The buffer doesn't exist, so this fails if the data get accessed */
+    const char gltf[] = R"({
+        "asset": {"version": "2.0"},
+        "buffers": [{"uri": "nonexistent.bin", "byteLength": 36}],
+        "bufferViews": [{"buffer": 0, "byteLength": 36}],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3",
+             "min": [-1.5, 0.25, -3.0], "max": [2.0, 4.5, 0.0]},
+            {"bufferView": 0, "componentType": 5120, "normalized": true, "count": 3, "type": "VEC3",
+             "min": [-128, -127, 0], "max": [127, 0, 127]}
+        ],
+        "meshes": [
+            {"primitives": [{"attributes": {"POSITION": 0}}]},
+            {"primitives": [{"attributes": {"POSITION": 1}}]}
+        ]
+    })";
+    CORRADE_VERIFY(importer->openData({gltf, sizeof(gltf) - 1}));
+
+    auto& gltfImporter = static_cast<TinyGltfImporter&>(*importer);
+    {
+        const Containers::Optional<Range3D> bounds = gltfImporter.meshBounds(0);
+        CORRADE_VERIFY(bounds);
+        CORRADE_COMPARE(*bounds, (Range3D{{-1.5f, 0.25f, -3.0f}, {2.0f, 4.5f, 0.0f}}));
+    }
+
+    /* Normalized the same way as the data, -128 is clamped to -1 */
+    {
+        const Containers::Optional<Range3D> bounds = gltfImporter.meshBounds(1);
+        CORRADE_VERIFY(bounds);
+        CORRADE_COMPARE(*bounds, (Range3D{{-1.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 1.0f}}));
+    }
+}
+
+void TinyGltfImporterTest::meshBoundsNoPositions() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+
+    const char gltf[] = R"({
+        "asset": {"version": "2.0"},
+        "meshes": [{"primitives": [{"attributes": {}}]}]
+    })";
+    CORRADE_VERIFY(importer->openData({gltf, sizeof(gltf) - 1}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!static_cast<TinyGltfImporter&>(*importer).meshBounds(0));
+    CORRADE_COMPARE(out.str(), "Trade::TinyGltfImporter::meshBounds(): mesh 0 has no attribute POSITION\n");
+}
+
+void TinyGltfImporterTest::meshAttributeAccessorOutOfRange() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+
+    const char gltf[] = R"({
+        "asset": {"version": "2.0"},
+        "accessors": [{"componentType": 5126, "count": 0, "type": "VEC3"}],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 1}}]}]
+    })";
+    CORRADE_VERIFY(importer->openData({gltf, sizeof(gltf) - 1}));
+
+    TinyGltfImporter& gltfImporter = static_cast<TinyGltfImporter&>(*importer);
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_VERIFY(!gltfImporter.meshBounds(0));
+    CORRADE_VERIFY(!gltfImporter.attributeData(0, "POSITION"));
+    CORRADE_COMPARE(out.str(),
+        "Trade::TinyGltfImporter::mesh3D(): accessor 1 out of range for 1 accessors\n"
+        "Trade::TinyGltfImporter::meshBounds(): accessor 1 out of range for 1 accessors\n"
+        "Trade::TinyGltfImporter::attributeData(): accessor 1 out of range for 1 accessors\n");
+}
+
+void TinyGltfImporterTest::meshWithStride() {
+    auto&& data = SingleFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh-with-stride" + std::string{data.suffix})));
+
+    /* First has a stride of 12 bytes (no interleaving), second has a stride
+       of 24 bytes. Neither should fail. */
+    CORRADE_VERIFY(importer->mesh3D(0));
+    CORRADE_VERIFY(importer->mesh3D(1));
 }
 
 void TinyGltfImporterTest::meshMultiplePrimitives() {
@@ -1933,6 +2538,108 @@ void TinyGltfImporterTest::image() {
     CORRADE_COMPARE_AS(image->data(), Containers::arrayView(ExpectedImageData).prefix(60), TestSuite::Compare::Container);
 }
 
+void TinyGltfImporterTest::imagePrefetch() {
+    auto&& data = ImageData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(_manager.loadState("PngImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("PngImporter plugin not found, cannot test");
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "image" + std::string{data.suffix})));
+
+    /* Both images decoded in parallel */
+    importer->configuration().setValue("threads", 2);
+    CORRADE_VERIFY(static_cast<TinyGltfImporter&>(*importer).prefetchImages());
+
+    auto image = importer->image2D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->importerState());
+    CORRADE_COMPARE(image->size(), Vector2i(5, 3));
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(ExpectedImageData).prefix(60), TestSuite::Compare::Container);
+
+    /* The prefetched image is handed over, so it gets decoded again */
+    auto again = importer->image2D(1);
+    CORRADE_VERIFY(again);
+    CORRADE_COMPARE_AS(again->data(), Containers::arrayView(ExpectedImageData).prefix(60), TestSuite::Compare::Container);
+}
+
+void TinyGltfImporterTest::imagePrefetchInvalidDataUri() {
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+    const char gltf[] = R"({"asset": {"version": "2.0"}, "images": [{"uri": "data:image/png;base64,!!!!"}, {"uri": "data:image/png;base64,????"}]})";
+    CORRADE_VERIFY(importer->openData({gltf, sizeof(gltf) - 1}));
+
+    /* Errors from all workers get collected and printed in the requested
+       order on the calling thread, so they end up in the redirected output */
+    importer->configuration().setValue("threads", 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!static_cast<TinyGltfImporter&>(*importer).prefetchImages({1, 0}));
+    CORRADE_COMPARE(out.str(),
+        "Trade::TinyGltfImporter::prefetchImages(): image 1 has an invalid data URI\n"
+        "Trade::TinyGltfImporter::prefetchImages(): image 0 has an invalid data URI\n");
+}
+
+void TinyGltfImporterTest::imageCache() {
+    if(_manager.loadState("PngImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("PngImporter plugin not found, cannot test");
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+
+    /* Count how many times the image file gets loaded */
+    struct Files {
+        /* Each file has its own storage, as the glTF is loaded with
+           ImporterFileCallbackPolicy::LoadPermanent and has to stay in
+           scope until the importer is closed */
+        std::unordered_map<std::string, Containers::Array<char>> data;
+        Int imageLoadCount = 0;
+    } files;
+    importer->setFileCallback([](const std::string& filename, ImporterFileCallbackPolicy policy, Files& files)
+            -> Containers::Optional<Containers::ArrayView<const char>> {
+        if(policy == ImporterFileCallbackPolicy::Close) return {};
+        if(Utility::String::endsWith(filename, "texture.png"))
+            ++files.imageLoadCount;
+        auto found = files.data.find(filename);
+        if(found == files.data.end())
+            found = files.data.emplace(filename, Utility::Directory::read(filename)).first;
+        return Containers::optional(Containers::ArrayView<const char>{found->second});
+    }, files);
+
+    /* Both images are 5x3 RGBA, the cache fits just one of them */
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR, "image.gltf")));
+    importer->configuration().setValue("imageCacheSize", 60);
+
+    auto image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(files.imageLoadCount, 1);
+
+    /* Second lookup is served from the cache, with its own copy of the data */
+    auto cached = importer->image2D(0);
+    CORRADE_VERIFY(cached);
+    CORRADE_COMPARE(files.imageLoadCount, 1);
+    CORRADE_VERIFY(cached->data().data() != image->data().data());
+    CORRADE_COMPARE(cached->importerState(), image->importerState());
+    CORRADE_COMPARE(cached->size(), Vector2i(5, 3));
+    CORRADE_COMPARE(cached->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE_AS(cached->data(), Containers::arrayView(ExpectedImageData).prefix(60), TestSuite::Compare::Container);
+
+    /* Loading the other image evicts the first one */
+    CORRADE_VERIFY(importer->image2D(1));
+    CORRADE_VERIFY(importer->image2D(1));
+    CORRADE_COMPARE(files.imageLoadCount, 2);
+    CORRADE_VERIFY(importer->image2D(0));
+    CORRADE_COMPARE(files.imageLoadCount, 3);
+
+    /* Images larger than the budget are not cached */
+    importer->configuration().setValue("imageCacheSize", 59);
+    CORRADE_VERIFY(importer->image2D(1));
+    CORRADE_VERIFY(importer->image2D(1));
+    CORRADE_COMPARE(files.imageLoadCount, 5);
+}
+
 void TinyGltfImporterTest::fileCallbackBuffer() {
     auto&& data = SingleFileData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -1976,9 +2683,46 @@ void TinyGltfImporterTest::fileCallbackBufferNotFound() {
     std::ostringstream out;
     Error redirectError{&out};
 
+    /* Buffers are loaded on first access, so opening succeeds */
     Utility::Resource rs{"data"};
-    CORRADE_VERIFY(!importer->openData(rs.getRaw("some/path/data" + std::string{data.suffix})));
-    CORRADE_COMPARE(out.str(), "Trade::TinyGltfImporter::openData(): error opening file: File read error : data.bin : file callback failed\n");
+    CORRADE_VERIFY(importer->openData(rs.getRaw("some/path/data" + std::string{data.suffix})));
+    CORRADE_VERIFY(!importer->mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::TinyGltfImporter::mesh3D(): cannot open buffer file data.bin\n");
+}
+
+void TinyGltfImporterTest::fileCallbackBufferPermanent() {
+    auto&& data = SingleFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::unique_ptr<AbstractImporter> importer = _manager.instantiate("TinyGltfImporter");
+
+    struct {
+        Utility::Resource rs{"data"};
+        std::ostringstream out;
+    } state;
+    importer->setFileCallback([](const std::string& filename, ImporterFileCallbackPolicy policy, decltype(state)& state) {
+        Debug{&state.out} << filename << policy;
+        return Containers::optional(state.rs.getRaw(filename));
+    }, state);
+
+    /* Buffers are loaded only on first access */
+    CORRADE_VERIFY(importer->openFile("some/path/data" + std::string{data.suffix}));
+    CORRADE_COMPARE(importer->mesh3DCount(), 1);
+    CORRADE_COMPARE(state.out.str(),
+        "some/path/data" + std::string{data.suffix} + " Trade::ImporterFileCallbackPolicy::LoadPermanent\n");
+
+    /* The buffer data are referenced in place, so both files are kept loaded
+       until the importer is closed. Accessing the mesh again doesn't load the
+       buffer again. */
+    CORRADE_VERIFY(importer->mesh3D(0));
+    CORRADE_VERIFY(importer->mesh3D(0));
+    importer->close();
+
+    CORRADE_COMPARE(state.out.str(),
+        "some/path/data" + std::string{data.suffix} + " Trade::ImporterFileCallbackPolicy::LoadPermanent\n"
+        "some/path/data.bin Trade::ImporterFileCallbackPolicy::LoadPermanent\n"
+        "some/path/data" + std::string{data.suffix} + " Trade::ImporterFileCallbackPolicy::Close\n"
+        "some/path/data.bin Trade::ImporterFileCallbackPolicy::Close\n");
 }
 
 void TinyGltfImporterTest::fileCallbackImage() {
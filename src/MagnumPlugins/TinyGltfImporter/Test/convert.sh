@@ -3,17 +3,17 @@
 set -e
 
 # in -> bin
-for i in animation animation-patching external-data mesh-colors mesh-primitives mesh; do
+for i in animation animation-patching external-data mesh-colors mesh-interleaved mesh-meshopt mesh-primitives mesh-quantized mesh-sparse mesh; do
     ./in2bin.py ${i}.bin.in
 done
 
 # gltf -> embedded gltf
-for i in animation image image-buffer mesh-colors mesh-primitives mesh; do
+for i in animation image image-buffer mesh-colors mesh-interleaved mesh-primitives mesh-quantized mesh-sparse mesh; do
     ./gltf2embedded.py ${i}.gltf
 done
 
 # gltf -> glb
-for i in animation animation-embedded camera empty image image-embedded image-buffer image-buffer-embedded light material-blinnphong material-metallicroughness material-specularglossiness material-properties mesh-colors mesh-colors-embedded mesh-primitives mesh-primitives-embedded mesh-with-stride mesh mesh-embedded scene scene-nodefault object-transformation texture-default-sampler texture; do
+for i in animation animation-embedded camera empty image image-embedded image-buffer image-buffer-embedded light material-blinnphong material-metallicroughness material-specularglossiness material-properties mesh-colors mesh-colors-embedded mesh-interleaved mesh-interleaved-embedded mesh-quantized mesh-quantized-embedded mesh-sparse mesh-sparse-embedded mesh-primitives mesh-primitives-embedded mesh-with-stride mesh mesh-embedded scene scene-nodefault object-transformation texture-default-sampler texture; do
     ./gltf2glb.py ${i}.gltf
 done
 
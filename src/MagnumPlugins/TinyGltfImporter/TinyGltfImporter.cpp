@@ -28,8 +28,17 @@
 #include "TinyGltfImporter.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <limits>
+#include <list>
+#include <mutex>
+#include <sstream>
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) && defined(CORRADE_BUILD_MULTITHREADED)
+#include <thread>
+#endif
 #include <unordered_map>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
@@ -38,6 +47,7 @@
 #include <Magnum/PixelFormat.h>
 #include <Magnum/Math/CubicHermite.h>
 #include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Range.h>
 #include <Magnum/Math/Quaternion.h>
 #include <Magnum/Trade/AnimationData.h>
 #include <Magnum/Trade/CameraData.h>
@@ -50,27 +60,24 @@
 #include <Magnum/Trade/MeshObjectData3D.h>
 
 #include "MagnumPlugins/AnyImageImporter/AnyImageImporter.h"
+#include "MagnumPlugins/TinyGltfImporter/GltfParser.h"
+#include "MagnumPlugins/TinyGltfImporter/MeshOptDecoder.h"
+
+/* Only the model definitions are used, the JSON is parsed by GltfParser.cpp
+   and the data are referenced in place. Include like this instead of
+   "MagnumExternal/TinyGltf/tiny_gltf.h" so we can include it as a system
+   header and suppress warnings. */
+#include "tiny_gltf.h"
 
-#define TINYGLTF_IMPLEMENTATION
-/* Opt out of tinygltf stb_image dependency */
-#define TINYGLTF_NO_STB_IMAGE
-#define TINYGLTF_NO_STB_IMAGE_WRITE
-/* Opt out of loading external images */
-#define TINYGLTF_NO_EXTERNAL_IMAGE
-
-#ifdef CORRADE_TARGET_WINDOWS
-/* Tinygltf includes some windows headers, avoid including more than ncessary
-   to speed up compilation. WIN32_LEAN_AND_MEAN and NOMINMAX is already defined
-   by CMake. */
-#define VC_EXTRALEAN
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define MAGNUM_TINYGLTFIMPORTER_USE_MMAP
 #endif
 
-/* Include like this instead of "MagnumExternal/TinyGltf/tiny_gltf.h" so we can
-   include it as a system header and suppress warnings */
-#include "tiny_gltf.h"
-#ifdef CORRADE_TARGET_WINDOWS
-#undef near
-#undef far
+/* MSVC doesn't define __SSE2__, but it's always available on x64 and with
+   /arch:SSE2 on x86 */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP == 2)
+#define MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+#include <emmintrin.h>
 #endif
 
 namespace Magnum { namespace Trade {
@@ -79,36 +86,427 @@ using namespace Magnum::Math::Literals;
 
 namespace {
 
-bool loadImageData(tinygltf::Image* image, std::string*, std::string*, int, int, const unsigned char* data, int size, void*) {
-    /* In case the image is an embedded URI, copy its decoded value to the data
-       buffer. In all other cases we'll access the referenced buffer or
-       external file directly from the doImage2D() implementation. */
-    if(image->bufferView == -1 && image->uri.empty())
-        image->image.assign(data, data + size);
-
-    return true;
-}
-
 std::size_t elementSize(const tinygltf::Accessor& accessor) {
     /* GetTypeSizeInBytes() is totally bogus and misleading name, it should
        have been called GetTypeComponentCount but who am I to judge. */
     return tinygltf::GetComponentSizeInBytes(accessor.componentType)*tinygltf::GetTypeSizeInBytes(accessor.type);
 }
 
-Containers::ArrayView<const char> bufferView(const tinygltf::Model& model, const tinygltf::Accessor& accessor) {
-    const std::size_t bufferElementSize = elementSize(accessor);
-    CORRADE_INTERNAL_ASSERT(std::size_t(accessor.bufferView) < model.bufferViews.size());
+/* Whether count elements of given size, stride bytes apart and starting at
+   offset fit into size bytes. Compares using subtraction so huge offsets or
+   counts coming from the file can't overflow. Expects that count is not
+   zero. */
+bool fitsInto(const std::size_t dataSize, const std::size_t offset, const std::size_t count, const std::size_t stride, const std::size_t elementSize) {
+    if(offset > dataSize || elementSize > dataSize - offset) return false;
+    return !stride || count - 1 <= (dataSize - offset - elementSize)/stride;
+}
+
+/* Stride of accessor data resolved by loadAccessor(). Sparse accessors and
+   accessors without a buffer view are expanded to a tightly packed copy. */
+std::size_t accessorStride(const tinygltf::Model& model, const tinygltf::Accessor& accessor) {
+    const std::size_t size = elementSize(accessor);
+    if(accessor.sparse.isSparse || accessor.bufferView == -1) return size;
     const tinygltf::BufferView& bufferView = model.bufferViews[accessor.bufferView];
-    CORRADE_INTERNAL_ASSERT(std::size_t(bufferView.buffer) < model.buffers.size());
-    const tinygltf::Buffer& buffer = model.buffers[bufferView.buffer];
+    return bufferView.byteStride ? bufferView.byteStride : size;
+}
+
+/* Tightly packed data of an accessor resolved by loadAccessor() */
+Containers::ArrayView<const char> accessorView(const tinygltf::Model& model, const std::vector<Containers::ArrayView<const char>>& accessors, const Int id) {
+    const tinygltf::Accessor& accessor = model.accessors[id];
+    CORRADE_INTERNAL_ASSERT(accessorStride(model, accessor) == elementSize(accessor));
+    return accessors[id];
+}
+
+/* Copy of one vertex attribute from a (possibly interleaved) buffer view into
+   the output array. If flipY is set, the attribute is a two-component float
+   texture coordinate and the Y component is flipped as part of the copy. */
+struct AttributeCopy {
+    Int bufferView;
+    std::size_t count;
+    std::size_t size;
+    const char* src;
+    std::size_t srcStride;
+    char* dst;
+    std::size_t dstStride;
+    bool flipY;
+};
+
+AttributeCopy attributeCopy(const tinygltf::Model& model, const std::vector<Containers::ArrayView<const char>>& accessors, const Int id, void* const dst, const std::size_t dstStride, const bool flipY) {
+    const tinygltf::Accessor& accessor = model.accessors[id];
+    /* Expanded sparse accessors don't share the data with anything, give
+       them a unique negative ID so they're not grouped with the base view */
+    const Int group = accessor.sparse.isSparse || accessor.bufferView == -1 ? -1 - id : accessor.bufferView;
+    return {group, accessor.count, elementSize(accessor),
+        accessors[id].data(), accessorStride(model, accessor),
+        static_cast<char*>(dst), dstStride, flipY};
+}
+
+/* Copies tightly packed two-component float texture coordinates, flipping
+   the Y component on the way */
+void copyFlipY(const char* const src, const std::size_t count, char* const dst) {
+    const Float* const in = reinterpret_cast<const Float*>(src);
+    Float* const out = reinterpret_cast<Float*>(dst);
+    std::size_t i = 0;
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+    /* Two coordinates in each register, y' = 1 - y done as y*-1 + 1 */
+    const __m128 sign = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+    const __m128 offset = _mm_setr_ps(0.0f, 1.0f, 0.0f, 1.0f);
+    for(; i + 4 <= count*2; i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in + i), sign), offset));
+    #endif
+    for(; i != count*2; i += 2) {
+        out[i] = in[i];
+        out[i + 1] = 1.0f - in[i + 1];
+    }
+}
+
+/* Conversion of quantized attribute data (KHR_mesh_quantization) to floats.
+   The source is tightly packed, converted in a single flat loop if the output
+   has the same component count. Texture coordinates have their Y component
+   flipped in the same loop if flipY is set. */
+struct Dequantization {
+    const char* src;
+    std::size_t count;
+    UnsignedInt components;
+    Int componentType;
+    bool normalized;
+    Float* dst;
+    UnsignedInt dstComponents;
+    bool flipY;
+};
+
+/* The conversion is done in floats, with the normalization applied as a
+   multiplication. Signed normalized values are clamped to -1 as the spec
+   says, the clamp is a no-op for unsigned types. The flip is then applied
+   as a multiply-add, which is an identity for components that aren't
+   flipped. */
+template<class T> inline Float dequantizeOne(const T value, const Float scale, const Float min, const Float sign, const Float offset) {
+    return Math::max(Float(value)*scale, min)*sign + offset;
+}
+
+/* Per-component multiply-add for the flip, alternating between the two
+   components of a texture coordinate. Flat data always start at an even
+   component, so the pattern is the same for every four-component chunk. */
+struct FlipY {
+    explicit FlipY(const bool flip): sign{1.0f, flip ? -1.0f : 1.0f}, offset{0.0f, flip ? 1.0f : 0.0f} {}
+
+    Float sign[2];
+    Float offset[2];
+};
+
+#ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+struct DequantizeConstants {
+    explicit DequantizeConstants(const Float scale, const Float min, const FlipY& flip):
+        scale{_mm_set1_ps(scale)}, min{_mm_set1_ps(min)},
+        sign{_mm_setr_ps(flip.sign[0], flip.sign[1], flip.sign[0], flip.sign[1])},
+        offset{_mm_setr_ps(flip.offset[0], flip.offset[1], flip.offset[0], flip.offset[1])} {}
+
+    __m128 scale, min, sign, offset;
+};
+
+inline void dequantizeStore(Float* const dst, const __m128i values, const DequantizeConstants& c) {
+    _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(values), c.scale), c.min), c.sign), c.offset));
+}
+#endif
+
+void dequantizeFlat(const Byte* const src, const std::size_t count, Float* const dst, const Float scale, const Float min, const FlipY& flip) {
+    std::size_t i = 0;
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+    const DequantizeConstants c{scale, min, flip};
+    for(; i + 16 <= count; i += 16) {
+        /* Put each byte into the top of a 32-bit lane and shift it back with
+           sign extension */
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo = _mm_unpacklo_epi8(v, v), hi = _mm_unpackhi_epi8(v, v);
+        dequantizeStore(dst + i +  0, _mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 24), c);
+        dequantizeStore(dst + i +  4, _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 24), c);
+        dequantizeStore(dst + i +  8, _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 24), c);
+        dequantizeStore(dst + i + 12, _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 24), c);
+    }
+    #endif
+    for(; i != count; ++i) dst[i] = dequantizeOne(src[i], scale, min, flip.sign[i & 1], flip.offset[i & 1]);
+}
+
+void dequantizeFlat(const UnsignedByte* const src, const std::size_t count, Float* const dst, const Float scale, const Float min, const FlipY& flip) {
+    std::size_t i = 0;
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+    const DequantizeConstants c{scale, min, flip};
+    const __m128i zero = _mm_setzero_si128();
+    for(; i + 16 <= count; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+        dequantizeStore(dst + i +  0, _mm_unpacklo_epi16(lo, zero), c);
+        dequantizeStore(dst + i +  4, _mm_unpackhi_epi16(lo, zero), c);
+        dequantizeStore(dst + i +  8, _mm_unpacklo_epi16(hi, zero), c);
+        dequantizeStore(dst + i + 12, _mm_unpackhi_epi16(hi, zero), c);
+    }
+    #endif
+    for(; i != count; ++i) dst[i] = dequantizeOne(src[i], scale, min, flip.sign[i & 1], flip.offset[i & 1]);
+}
+
+void dequantizeFlat(const Short* const src, const std::size_t count, Float* const dst, const Float scale, const Float min, const FlipY& flip) {
+    std::size_t i = 0;
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+    const DequantizeConstants c{scale, min, flip};
+    for(; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        dequantizeStore(dst + i + 0, _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16), c);
+        dequantizeStore(dst + i + 4, _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16), c);
+    }
+    #endif
+    for(; i != count; ++i) dst[i] = dequantizeOne(src[i], scale, min, flip.sign[i & 1], flip.offset[i & 1]);
+}
+
+void dequantizeFlat(const UnsignedShort* const src, const std::size_t count, Float* const dst, const Float scale, const Float min, const FlipY& flip) {
+    std::size_t i = 0;
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_SSE2
+    const DequantizeConstants c{scale, min, flip};
+    const __m128i zero = _mm_setzero_si128();
+    for(; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        dequantizeStore(dst + i + 0, _mm_unpacklo_epi16(v, zero), c);
+        dequantizeStore(dst + i + 4, _mm_unpackhi_epi16(v, zero), c);
+    }
+    #endif
+    for(; i != count; ++i) dst[i] = dequantizeOne(src[i], scale, min, flip.sign[i & 1], flip.offset[i & 1]);
+}
+
+template<class T> void dequantize(const Dequantization& d) {
+    const T* const src = reinterpret_cast<const T*>(d.src);
+    const Float scale = d.normalized ? 1.0f/Float(std::numeric_limits<T>::max()) : 1.0f;
+    const Float min = d.normalized ? -1.0f : -std::numeric_limits<Float>::infinity();
+
+    const FlipY flip{d.flipY};
+
+    if(d.components == d.dstComponents)
+        return dequantizeFlat(src, d.count*d.components, d.dst, scale, min, flip);
+
+    /* Three-component colors written to four-component output, these are
+       never flipped */
+    CORRADE_INTERNAL_ASSERT(!d.flipY);
+    for(std::size_t i = 0; i != d.count; ++i)
+        for(std::size_t j = 0; j != d.components; ++j)
+            d.dst[i*d.dstComponents + j] = dequantizeOne(src[i*d.components + j], scale, min, 1.0f, 0.0f);
+}
+
+/* All attribute extraction work for a single mesh */
+struct AttributeExtraction {
+    std::vector<AttributeCopy> copies;
+    std::vector<Dequantization> dequantizations;
+    /* Tightly packed copies of interleaved quantized data */
+    std::vector<Containers::Array<char>> temporaries;
+};
+
+bool isQuantized(const Int componentType) {
+    return componentType == TINYGLTF_COMPONENT_TYPE_BYTE ||
+           componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE ||
+           componentType == TINYGLTF_COMPONENT_TYPE_SHORT ||
+           componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
+}
+
+/* Converts a value of the accessor min/max properties to a float. The
+   normalized property doesn't affect these, so the normalization is applied
+   here, the same way as when dequantizing the data. */
+Float boundValue(const Double value, const Int componentType, const bool normalized) {
+    if(!normalized || componentType == TINYGLTF_COMPONENT_TYPE_FLOAT)
+        return Float(value);
+
+    Float max;
+    if(componentType == TINYGLTF_COMPONENT_TYPE_BYTE)
+        max = std::numeric_limits<Byte>::max();
+    else if(componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+        max = std::numeric_limits<UnsignedByte>::max();
+    else if(componentType == TINYGLTF_COMPONENT_TYPE_SHORT)
+        max = std::numeric_limits<Short>::max();
+    else max = std::numeric_limits<UnsignedShort>::max();
+
+    return Math::max(Float(value)*(1.0f/max), -1.0f);
+}
+
+/* Schedules extraction of an attribute to a float output with given
+   component count. Float data are copied directly, quantized data are
+   dequantized from the source if they're tightly packed or gathered in the
+   same pass as other attributes of the view and dequantized after. The Y
+   flip of texture coordinates is done by whichever of the two writes the
+   output. */
+void addAttribute(AttributeExtraction& extraction, const tinygltf::Model& model, const std::vector<Containers::ArrayView<const char>>& accessors, const Int id, Float* const dst, const UnsignedInt dstComponents, const bool flipY = false) {
+    const tinygltf::Accessor& accessor = model.accessors[id];
+    if(!isQuantized(accessor.componentType)) {
+        extraction.copies.push_back(attributeCopy(model, accessors, id, dst, dstComponents*sizeof(Float), flipY));
+        return;
+    }
+
+    AttributeCopy copy = attributeCopy(model, accessors, id, nullptr, 0, false);
+    const char* src = copy.src;
+    if(copy.srcStride != copy.size) {
+        extraction.temporaries.emplace_back(Containers::NoInit, copy.count*copy.size);
+        copy.dst = extraction.temporaries.back();
+        copy.dstStride = copy.size;
+        extraction.copies.push_back(copy);
+        src = copy.dst;
+    }
+
+    extraction.dequantizations.push_back({src, copy.count,
+        UnsignedInt(tinygltf::GetTypeSizeInBytes(accessor.type)),
+        accessor.componentType, accessor.normalized, dst, dstComponents, flipY});
+}
+
+/* Performs all copies, attributes sharing the same buffer view are extracted
+   together in a single pass over the view */
+void copyAttributes(std::vector<AttributeCopy>& copies) {
+    std::stable_sort(copies.begin(), copies.end(), [](const AttributeCopy& a, const AttributeCopy& b) {
+        return a.bufferView < b.bufferView || (a.bufferView == b.bufferView && a.count < b.count);
+    });
+
+    for(auto it = copies.begin(); it != copies.end(); ) {
+        auto end = it + 1;
+        while(end != copies.end() && end->bufferView == it->bufferView && end->count == it->count) ++end;
+
+        /* Tightly packed attribute alone in its view, copy everything at
+           once */
+        if(end - it == 1 && it->srcStride == it->size && it->dstStride == it->size) {
+            if(it->flipY) copyFlipY(it->src, it->count, it->dst);
+            else if(it->count) std::memcpy(it->dst, it->src, it->count*it->size);
+
+        /* Interleaved or padded attributes, go over the view only once */
+        } else for(std::size_t i = 0; i != it->count; ++i) {
+            for(auto c = it; c != end; ++c) {
+                char* const dst = c->dst + i*c->dstStride;
+                std::memcpy(dst, c->src + i*c->srcStride, c->size);
+                if(c->flipY) {
+                    Float& y = reinterpret_cast<Float*>(dst)[1];
+                    y = 1.0f - y;
+                }
+            }
+        }
+
+        it = end;
+    }
+}
+
+void extractAttributes(AttributeExtraction& extraction) {
+    copyAttributes(extraction.copies);
+
+    for(const Dequantization& d: extraction.dequantizations) {
+        if(!d.count) continue;
+        if(d.componentType == TINYGLTF_COMPONENT_TYPE_BYTE)
+            dequantize<Byte>(d);
+        else if(d.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+            dequantize<UnsignedByte>(d);
+        else if(d.componentType == TINYGLTF_COMPONENT_TYPE_SHORT)
+            dequantize<Short>(d);
+        else if(d.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+            dequantize<UnsignedShort>(d);
+        else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+/* Scatters sparse accessor values into the expanded data in a single pass
+   over the sparse indices, returns false if an index is out of range */
+template<class T> bool scatterSparse(char* const dst, const std::size_t count, const std::size_t size, const Containers::ArrayView<const char> indices, const char* const values) {
+    const T* const sparseIndices = reinterpret_cast<const T*>(indices.data());
+    const std::size_t sparseCount = indices.size()/sizeof(T);
+    for(std::size_t i = 0; i != sparseCount; ++i) {
+        const std::size_t index = sparseIndices[i];
+        if(index >= count) return false;
+        std::memcpy(dst + index*size, values + i*size, size);
+    }
+
+    return true;
+}
+
+/* Integer property of an extension object, returns -1 if not present */
+Int extensionProperty(const tinygltf::Value& extension, const char* const name) {
+    if(!extension.IsObject()) return -1;
+    const tinygltf::Value& value = extension.Get(name);
+    return value.IsInt() ? value.Get<int>() : -1;
+}
+
+std::string extensionStringProperty(const tinygltf::Value& extension, const char* const name, const std::string& defaultValue) {
+    if(!extension.IsObject()) return defaultValue;
+    const tinygltf::Value& value = extension.Get(name);
+    return value.IsString() ? value.Get<std::string>() : defaultValue;
+}
 
-    CORRADE_INTERNAL_ASSERT(bufferView.byteStride == 0 || bufferView.byteStride == bufferElementSize);
-    return {reinterpret_cast<const char*>(buffer.data.data()) + bufferView.byteOffset + accessor.byteOffset, accessor.count*bufferElementSize};
+/* Whether the data are a binary glTF file, based on the magic */
+bool isBinaryGltf(const Containers::ArrayView<const char> data) {
+    return data.size() >= 4 && std::strncmp(data.data(), "glTF", 4) == 0;
 }
 
-template<class T> Containers::ArrayView<const T> bufferView(const tinygltf::Model& model, const tinygltf::Accessor& accessor) {
-    CORRADE_INTERNAL_ASSERT(elementSize(accessor) == sizeof(T));
-    return Containers::arrayCast<const T>(bufferView(model, accessor));
+/* Binary chunk of a binary glTF file. The header was already validated in
+   doOpenData(), returns an empty view if there's no binary chunk. */
+Containers::ArrayView<const char> binaryChunk(const Containers::ArrayView<const char> data) {
+    UnsignedInt jsonChunkLength;
+    std::memcpy(&jsonChunkLength, data + 12, 4);
+    const std::size_t offset = 20 + std::size_t(jsonChunkLength);
+    if(data.size() < offset + 8) return nullptr;
+
+    UnsignedInt chunkLength, chunkType;
+    std::memcpy(&chunkLength, data + offset, 4);
+    std::memcpy(&chunkType, data + offset + 4, 4);
+    /* "BIN\0" */
+    if(chunkType != 0x004e4942) return nullptr;
+
+    return data.slice(offset + 8, Math::min(data.size(), offset + 8 + chunkLength));
+}
+
+/* Decodes a base64 data URI. The output size is known upfront, so the data
+   are decoded directly into the final allocation without any temporaries. */
+Containers::Optional<Containers::Array<char>> decodeDataUri(const std::string& uri) {
+    static const struct Table {
+        Table() {
+            std::fill_n(values, 256, -1);
+            const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for(Int i = 0; i != 64; ++i) values[UnsignedByte(alphabet[i])] = i;
+        }
+
+        Int values[256];
+    } table;
+
+    /* Only base64-encoded data URIs are supported */
+    const std::size_t comma = uri.find(',');
+    if(comma == std::string::npos || comma < 12 || uri.compare(comma - 7, 7, ";base64") != 0)
+        return Containers::NullOpt;
+
+    const char* in = uri.data() + comma + 1;
+    std::size_t size = uri.size() - comma - 1;
+    if(size % 4) return Containers::NullOpt;
+    std::size_t padding = 0;
+    if(size && in[size - 1] == '=') ++padding;
+    if(size && in[size - 2] == '=') ++padding;
+
+    Containers::Array<char> out{Containers::NoInit, size/4*3 - padding};
+    std::size_t o = 0;
+    for(std::size_t i = 0; i != size; i += 4) {
+        const Int a = table.values[UnsignedByte(in[i + 0])];
+        const Int b = table.values[UnsignedByte(in[i + 1])];
+        /* Padding is allowed only in the last quadruplet */
+        const Int c = i + 4 == size && padding >= 2 ? 0 : table.values[UnsignedByte(in[i + 2])];
+        const Int d = i + 4 == size && padding >= 1 ? 0 : table.values[UnsignedByte(in[i + 3])];
+        if((a|b|c|d) < 0) return Containers::NullOpt;
+
+        const UnsignedInt triplet = (a << 18)|(b << 12)|(c << 6)|d;
+        out[o++] = char(triplet >> 16);
+        if(o != out.size()) out[o++] = char(triplet >> 8);
+        if(o != out.size()) out[o++] = char(triplet);
+    }
+
+    return Containers::optional(std::move(out));
+}
+
+ImageData2D copyImage(const ImageData2D& image, const void* importerState) {
+    Containers::Array<char> data{Containers::NoInit, image.data().size()};
+    std::copy(image.data().begin(), image.data().end(), data.begin());
+
+    if(image.isCompressed()) {
+        if(isCompressedPixelFormatImplementationSpecific(image.compressedFormat()))
+            return ImageData2D{image.compressedStorage(), compressedPixelFormatUnwrap(image.compressedFormat()), image.size(), std::move(data), importerState};
+        return ImageData2D{image.compressedStorage(), image.compressedFormat(), image.size(), std::move(data), importerState};
+    }
+
+    if(isPixelFormatImplementationSpecific(image.format()))
+        return ImageData2D{image.storage(), pixelFormatUnwrap(image.format()), image.formatExtra(), image.pixelSize(), image.size(), std::move(data), importerState};
+    return ImageData2D{image.storage(), image.format(), image.size(), std::move(data), importerState};
 }
 
 }
@@ -150,6 +548,57 @@ struct TinyGltfImporter::Document {
     std::vector<std::pair<std::size_t, std::size_t>> nodeMap;
     std::vector<std::size_t> nodeSizeOffsets;
 
+    /* Data passed to doOpenData() that are guaranteed to stay in scope until
+       the file is closed, set by doOpenFile() */
+    Containers::ArrayView<const char> persistentData;
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_MMAP
+    /* Binary glTF file opened through openFile(), kept mapped so the binary
+       chunk can be referenced in place */
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped;
+    #endif
+    /* Copy of the binary chunk if the data passed to openData() were not
+       persistent */
+    Containers::Array<char> binaryChunkCopy;
+    /* Binary chunk of a binary glTF file, pointing either to the persistent
+       data or to the copy above */
+    Containers::ArrayView<const char> binaryChunk;
+
+    /* Data of each buffer, resolved on first access by loadBuffer(). Points
+       either to the binary chunk, to memory returned by the file callback or
+       to one of the storages below. */
+    std::vector<Containers::ArrayView<const char>> bufferData;
+    std::vector<bool> bufferLoaded;
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_MMAP
+    std::vector<Containers::Array<const char, Utility::Directory::MapDeleter>> mappedBuffers;
+    #endif
+    /* Data of each buffer view, resolved on first access by
+       loadBufferView(). Points either into the buffer data above or, for
+       views compressed with EXT_meshopt_compression, to decoded data in
+       the storage below. */
+    std::vector<Containers::ArrayView<const char>> bufferViewData;
+    std::vector<bool> bufferViewLoaded;
+    /* Data of each accessor, resolved on first access by loadAccessor(),
+       spanning from the first to the end of the last element. Points either
+       into the buffer view data above or, for sparse accessors, to an
+       expanded copy in the storage below. */
+    std::vector<Containers::ArrayView<const char>> accessorData;
+    std::vector<bool> accessorLoaded;
+    std::vector<Containers::Array<char>> decodedBuffers;
+    /* Files loaded through the file callback with
+       ImporterFileCallbackPolicy::LoadPermanent, closed in doClose() */
+    std::vector<std::string> callbackFiles;
+    /* Images decoded in advance by prefetchImages(), handed over to the
+       first image2D() call for given ID */
+    std::vector<Containers::Optional<ImageData2D>> prefetchedImages;
+    /* Images decoded by image2D(), kept while they fit into the
+       imageCacheSize budget. The use order is tracked in a list with the
+       most recently used image at the front, each cached image stores its
+       position in it so both a cache hit and an eviction are O(1). */
+    std::vector<Containers::Optional<ImageData2D>> cachedImages;
+    std::list<UnsignedInt> cachedImageUseOrder;
+    std::vector<std::list<UnsignedInt>::iterator> cachedImageUse;
+    std::size_t imageCacheUsed = 0;
+
     bool open = false;
 };
 
@@ -160,6 +609,9 @@ void fillDefaultConfiguration(Utility::ConfigurationGroup& conf) {
     conf.setValue("optimizeQuaternionShortestPath", true);
     conf.setValue("normalizeQuaternions", true);
     conf.setValue("mergeAnimationClips", false);
+    conf.setValue("textureCoordinateYFlipInShader", false);
+    conf.setValue("threads", 1);
+    conf.setValue("imageCacheSize", 0);
 }
 
 }
@@ -182,56 +634,119 @@ auto TinyGltfImporter::doFeatures() const -> Features { return Feature::OpenData
 
 bool TinyGltfImporter::doIsOpened() const { return !!_d && _d->open; }
 
-void TinyGltfImporter::doClose() { _d = nullptr; }
+void TinyGltfImporter::doClose() {
+    /* Tell the callback that the permanently loaded files are not needed
+       anymore */
+    if(_d) for(const std::string& filename: _d->callbackFiles)
+        fileCallback()(filename, ImporterFileCallbackPolicy::Close, fileCallbackUserData());
+
+    _d = nullptr;
+}
 
 void TinyGltfImporter::doOpenFile(const std::string& filename) {
     _d.reset(new Document);
     _d->filePath = Utility::Directory::path(filename);
+
+    /* Load the file permanently so the binary chunk of a binary glTF can be
+       referenced in place */
+    if(fileCallback()) {
+        const Containers::Optional<Containers::ArrayView<const char>> data = fileCallback()(filename, ImporterFileCallbackPolicy::LoadPermanent, fileCallbackUserData());
+        if(!data) {
+            Error{} << "Trade::TinyGltfImporter::openFile(): cannot open file" << filename;
+            doClose();
+            return;
+        }
+
+        _d->callbackFiles.push_back(filename);
+        _d->persistentData = *data;
+        doOpenData(*data);
+        return;
+    }
+
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_MMAP
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped = Utility::Directory::mapRead(filename);
+    if(!mapped) {
+        Error{} << "Trade::TinyGltfImporter::openFile(): cannot open file" << filename;
+        doClose();
+        return;
+    }
+
+    /* Only the binary chunk of a binary glTF can be referenced in place, the
+       JSON is not needed after parsing */
+    const bool binary = isBinaryGltf(mapped);
+    if(binary) _d->persistentData = mapped;
+    doOpenData(mapped);
+    if(!_d) return;
+
+    /* Keep the mapping only if the binary chunk is referenced from it,
+       otherwise it gets unmapped and nothing may point to it anymore */
+    if(_d->binaryChunk) _d->mapped = std::move(mapped);
+    else _d->persistentData = nullptr;
+    #else
     AbstractImporter::doOpenFile(filename);
+    #endif
 }
 
 void TinyGltfImporter::doOpenData(const Containers::ArrayView<const char> data) {
-    tinygltf::TinyGLTF loader;
-    std::string err;
-
     if(!_d) _d.reset(new Document);
 
-    if(fileCallback()) {
-        tinygltf::FsCallbacks callbacks;
-        callbacks.user_data = this;
-        callbacks.FileExists = [](const std::string&, void*) { return true; };
-        callbacks.ExpandFilePath = [](const std::string& path, void*) {
-            return path;
-        };
-        callbacks.ReadWholeFile = [](std::vector<unsigned char>* out, std::string* err, const std::string& filename, void* userData) {
-            auto& self = *static_cast<TinyGltfImporter*>(userData);
-            Containers::Optional<Containers::ArrayView<const char>> data = self.fileCallback()(filename, ImporterFileCallbackPolicy::LoadTemporary, self.fileCallbackUserData());
-            if(!data) {
-                *err = "file callback failed";
-                return false;
-            }
-            out->assign(data->begin(), data->end());
-            return true;
-        };
-        loader.SetFsCallbacks(callbacks);
-    }
+    /* For binary files validate the header and extract the JSON chunk, the
+       binary chunk is referenced in place below. The checks and messages are
+       kept the same as with the original tinygltf parser. */
+    Containers::ArrayView<const char> json = data;
+    const bool binary = isBinaryGltf(data);
+    if(binary) {
+        if(data.size() < 20) {
+            Error{} << "Trade::TinyGltfImporter::openData(): error opening file: Too short data size for glTF Binary.";
+            doClose();
+            return;
+        }
 
-    loader.SetImageLoader(&loadImageData, nullptr);
+        UnsignedInt chunkLength, chunkFormat;
+        std::memcpy(&chunkLength, data + 12, 4);
+        std::memcpy(&chunkFormat, data + 16, 4);
+        /* "JSON" */
+        if(chunkLength < 1 || 20 + std::size_t(chunkLength) > data.size() || chunkFormat != 0x4e4f534a) {
+            Error{} << "Trade::TinyGltfImporter::openData(): error opening file: Invalid glTF binary.";
+            doClose();
+            return;
+        }
 
-    _d->open = true;
-    if(data.size() >= 4 && strncmp(data.data(), "glTF", 4) == 0) {
-        _d->open = loader.LoadBinaryFromMemory(&_d->model, &err, nullptr, reinterpret_cast<const unsigned char*>(data.data()), data.size(), _d->filePath, tinygltf::SectionCheck::NO_REQUIRE);
-    } else {
-        _d->open = loader.LoadASCIIFromString(&_d->model, &err, nullptr, data.data(), data.size(), _d->filePath, tinygltf::SectionCheck::NO_REQUIRE);
+        json = data.slice(20, 20 + chunkLength);
     }
 
+    std::string error;
+    _d->open = Implementation::parseGltf(json, _d->model, error);
     if(!_d->open) {
-        Utility::String::rtrimInPlace(err);
-        Error{} << "Trade::TinyGltfImporter::openData(): error opening file:" << err;
+        Error{} << "Trade::TinyGltfImporter::openData(): error opening file:" << error;
         doClose();
         return;
     }
 
+    /* Reference the binary chunk in place if the data stay in scope,
+       otherwise copy just the chunk, not the whole file */
+    if(binary) {
+        const Containers::ArrayView<const char> chunk = binaryChunk(data);
+        if(data.data() == _d->persistentData.data()) {
+            _d->binaryChunk = chunk;
+        } else {
+            _d->binaryChunkCopy = Containers::Array<char>{Containers::NoInit, chunk.size()};
+            std::copy(chunk.begin(), chunk.end(), _d->binaryChunkCopy.begin());
+            _d->binaryChunk = _d->binaryChunkCopy;
+        }
+    }
+
+    /* Buffers and buffer views are resolved lazily on first access */
+    _d->bufferData.resize(_d->model.buffers.size());
+    _d->bufferLoaded.resize(_d->model.buffers.size());
+    _d->bufferViewData.resize(_d->model.bufferViews.size());
+    _d->bufferViewLoaded.resize(_d->model.bufferViews.size());
+    _d->accessorData.resize(_d->model.accessors.size());
+    _d->accessorLoaded.resize(_d->model.accessors.size());
+    _d->prefetchedImages.resize(_d->model.images.size());
+    _d->cachedImages.resize(_d->model.images.size());
+    _d->cachedImageUse.resize(_d->model.images.size());
+
     /* Treat meshes with multiple primitives as separate meshes. Each mesh gets
        duplicated as many times as is the size of the primitives array. */
     _d->meshSizeOffsets.emplace_back(0);
@@ -284,6 +799,328 @@ std::string TinyGltfImporter::doCameraName(const UnsignedInt id) {
     return _d->model.cameras[id].name;
 }
 
+/* Resolves given buffer on first access and caches it for subsequent calls.
+   The prefix is used for error messages. */
+bool TinyGltfImporter::loadBuffer(const char* const prefix, const Int id) {
+    if(std::size_t(id) >= _d->model.buffers.size()) {
+        Error{} << prefix << "buffer" << id << "out of range for" << _d->model.buffers.size() << "buffers";
+        return false;
+    }
+
+    /* Already loaded */
+    if(_d->bufferLoaded[id]) return true;
+
+    const tinygltf::Buffer& buffer = _d->model.buffers[id];
+
+    /* Binary glTF chunk */
+    if(buffer.uri.empty()) {
+        if(!_d->binaryChunk) {
+            Error{} << prefix << "buffer" << id << "has no URI and there's no binary glTF chunk";
+            return false;
+        }
+
+        _d->bufferData[id] = _d->binaryChunk;
+        _d->bufferLoaded[id] = true;
+        return true;
+    }
+
+    /* Data URI, decode directly into the final storage */
+    if(Utility::String::beginsWith(buffer.uri, "data:")) {
+        Containers::Optional<Containers::Array<char>> decoded = decodeDataUri(buffer.uri);
+        if(!decoded) {
+            Error{} << prefix << "buffer" << id << "has an invalid data URI";
+            return false;
+        }
+
+        _d->bufferData[id] = *decoded;
+        _d->decodedBuffers.push_back(std::move(*decoded));
+        _d->bufferLoaded[id] = true;
+        return true;
+    }
+
+    /* External file. Loaded permanently through the callback, memory-mapped
+       or, as a last resort, read into memory. */
+    const std::string filename = Utility::Directory::join(_d->filePath, buffer.uri);
+    if(fileCallback()) {
+        const Containers::Optional<Containers::ArrayView<const char>> data = fileCallback()(filename, ImporterFileCallbackPolicy::LoadPermanent, fileCallbackUserData());
+        if(!data) {
+            Error{} << prefix << "cannot open buffer file" << filename;
+            return false;
+        }
+
+        _d->callbackFiles.push_back(filename);
+        _d->bufferData[id] = *data;
+        _d->bufferLoaded[id] = true;
+        return true;
+    }
+
+    #ifdef MAGNUM_TINYGLTFIMPORTER_USE_MMAP
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped = Utility::Directory::mapRead(filename);
+    if(!mapped) {
+        Error{} << prefix << "cannot open buffer file" << filename;
+        return false;
+    }
+
+    _d->bufferData[id] = mapped;
+    _d->mappedBuffers.push_back(std::move(mapped));
+    #else
+    if(!Utility::Directory::fileExists(filename)) {
+        Error{} << prefix << "cannot open buffer file" << filename;
+        return false;
+    }
+
+    Containers::Array<char> data = Utility::Directory::read(filename);
+    _d->bufferData[id] = data;
+    _d->decodedBuffers.push_back(std::move(data));
+    #endif
+    _d->bufferLoaded[id] = true;
+    return true;
+}
+
+/* Resolves given buffer view on first access and caches it for subsequent
+   calls. Uncompressed views reference the buffer data directly, views
+   compressed with EXT_meshopt_compression are decoded into a newly allocated
+   storage, so the decoding is done only for data that are actually used. */
+bool TinyGltfImporter::loadBufferView(const char* const prefix, const Int id) {
+    if(std::size_t(id) >= _d->model.bufferViews.size()) {
+        Error{} << prefix << "buffer view" << id << "out of range for" << _d->model.bufferViews.size() << "buffer views";
+        return false;
+    }
+
+    /* Already loaded */
+    if(_d->bufferViewLoaded[id]) return true;
+
+    const tinygltf::BufferView& bufferView = _d->model.bufferViews[id];
+
+    const auto meshopt = bufferView.extensions.find("EXT_meshopt_compression");
+    if(meshopt == bufferView.extensions.end()) {
+        if(!loadBuffer(prefix, bufferView.buffer)) return false;
+
+        /* Buffer views are not validated on opening and the buffer data are
+           referenced in place, so check that the view fits */
+        const Containers::ArrayView<const char> buffer = _d->bufferData[bufferView.buffer];
+        if(bufferView.byteOffset > buffer.size() || bufferView.byteLength > buffer.size() - bufferView.byteOffset) {
+            Error{} << prefix << "buffer view" << id << "is out of bounds";
+            return false;
+        }
+
+        _d->bufferViewData[id] = buffer.slice(bufferView.byteOffset, bufferView.byteOffset + bufferView.byteLength);
+        _d->bufferViewLoaded[id] = true;
+        return true;
+    }
+
+    /* The buffer referenced by a compressed view is usually just a
+       placeholder without any data, the compressed data are in the buffer
+       referenced by the extension */
+    const tinygltf::Value& extension = meshopt->second;
+    const Int buffer = extensionProperty(extension, "buffer");
+    const Int byteOffset = Math::max(extensionProperty(extension, "byteOffset"), 0);
+    const Int byteLength = extensionProperty(extension, "byteLength");
+    const Int byteStride = extensionProperty(extension, "byteStride");
+    const Int count = extensionProperty(extension, "count");
+    const std::string mode = extensionStringProperty(extension, "mode", {});
+    const std::string filter = extensionStringProperty(extension, "filter", "NONE");
+
+    if(buffer < 0 || byteLength < 0 || byteStride <= 0 || count < 0) {
+        Error{} << prefix << "buffer view" << id << "has invalid EXT_meshopt_compression properties";
+        return false;
+    }
+
+    bool valid;
+    if(mode == "ATTRIBUTES")
+        valid = byteStride % 4 == 0 && byteStride <= 256;
+    else if(mode == "TRIANGLES")
+        valid = (byteStride == 2 || byteStride == 4) && count % 3 == 0;
+    else if(mode == "INDICES")
+        valid = byteStride == 2 || byteStride == 4;
+    else {
+        Error{} << prefix << "buffer view" << id << "has unsupported EXT_meshopt_compression mode" << mode;
+        return false;
+    }
+
+    if(filter == "OCTAHEDRAL")
+        valid = valid && mode == "ATTRIBUTES" && (byteStride == 4 || byteStride == 8);
+    else if(filter == "QUATERNION")
+        valid = valid && mode == "ATTRIBUTES" && byteStride == 8;
+    else if(filter == "EXPONENTIAL")
+        valid = valid && mode == "ATTRIBUTES";
+    else if(filter != "NONE") {
+        Error{} << prefix << "buffer view" << id << "has unsupported EXT_meshopt_compression filter" << filter;
+        return false;
+    }
+
+    if(!valid) {
+        Error{} << prefix << "buffer view" << id << "has invalid EXT_meshopt_compression stride" << byteStride << "for" << count << "elements in mode" << mode << "and filter" << filter;
+        return false;
+    }
+
+    /* The decoded data have to fill the whole view, as the extension
+       requires. Checked before anything gets allocated, as the count can be
+       arbitrary. */
+    if(bufferView.byteLength/byteStride != std::size_t(count) || bufferView.byteLength%byteStride) {
+        Error{} << prefix << "buffer view" << id << "has" << bufferView.byteLength << "bytes but EXT_meshopt_compression has" << count << "elements with stride" << byteStride;
+        return false;
+    }
+
+    if(!loadBuffer(prefix, buffer)) return false;
+    const Containers::ArrayView<const char> data = _d->bufferData[buffer];
+    if(std::size_t(byteOffset) + std::size_t(byteLength) > data.size()) {
+        Error{} << prefix << "compressed data of buffer view" << id << "are out of bounds";
+        return false;
+    }
+
+    /* Reject counts that the compressed data can't encode, which also
+       limits the decoded size to a multiple of the compressed size */
+    std::size_t minByteLength;
+    if(mode == "ATTRIBUTES")
+        minByteLength = Implementation::meshOptVertexBufferMinSize(count, byteStride);
+    else if(mode == "TRIANGLES")
+        minByteLength = Implementation::meshOptIndexBufferMinSize(count);
+    else
+        minByteLength = Implementation::meshOptIndexSequenceMinSize(count);
+    if(std::size_t(byteLength) < minByteLength) {
+        Error{} << prefix << "compressed data of buffer view" << id << "are too short for" << count << "elements, expected at least" << minByteLength << "bytes but got" << byteLength;
+        return false;
+    }
+
+    const Containers::ArrayView<const char> compressed = data.slice(byteOffset, byteOffset + byteLength);
+    Containers::Array<char> decoded{Containers::NoInit, std::size_t(count)*byteStride};
+    bool decodedSuccessfully;
+    if(mode == "ATTRIBUTES")
+        decodedSuccessfully = Implementation::meshOptDecodeVertexBuffer(decoded, count, byteStride, compressed);
+    else if(mode == "TRIANGLES")
+        decodedSuccessfully = Implementation::meshOptDecodeIndexBuffer(decoded, count, byteStride, compressed);
+    else
+        decodedSuccessfully = Implementation::meshOptDecodeIndexSequence(decoded, count, byteStride, compressed);
+    if(!decodedSuccessfully) {
+        Error{} << prefix << "cannot decode buffer view" << id;
+        return false;
+    }
+
+    if(filter == "OCTAHEDRAL")
+        Implementation::meshOptFilterOctahedral(decoded, count, byteStride);
+    else if(filter == "QUATERNION")
+        Implementation::meshOptFilterQuaternion(decoded, count, byteStride);
+    else if(filter == "EXPONENTIAL")
+        Implementation::meshOptFilterExponential(decoded, count, byteStride);
+
+    _d->bufferViewData[id] = decoded;
+    _d->decodedBuffers.push_back(std::move(decoded));
+    _d->bufferViewLoaded[id] = true;
+    return true;
+}
+
+/* Resolves given accessor on first access and caches it for subsequent
+   calls. Regular accessors reference the buffer view data directly, sparse
+   accessors are expanded by copying the base view (or zero-filling if there's
+   none) and then patching the sparse values in. */
+bool TinyGltfImporter::loadAccessor(const char* const prefix, const Int id) {
+    if(std::size_t(id) >= _d->model.accessors.size()) {
+        Error{} << prefix << "accessor" << id << "out of range for" << _d->model.accessors.size() << "accessors";
+        return false;
+    }
+
+    /* Already loaded */
+    if(_d->accessorLoaded[id]) return true;
+
+    const tinygltf::Accessor& accessor = _d->model.accessors[id];
+
+    /* Empty accessors don't need any data */
+    if(!accessor.count) {
+        _d->accessorLoaded[id] = true;
+        return true;
+    }
+
+    /* Accessors are not validated on opening and the data are referenced in
+       place, so check that the accessed range fits into the view */
+    const std::size_t size = elementSize(accessor);
+    Containers::ArrayView<const char> base;
+    std::size_t stride = size;
+    if(accessor.bufferView != -1) {
+        if(!loadBufferView(prefix, accessor.bufferView)) return false;
+
+        const tinygltf::BufferView& bufferView = _d->model.bufferViews[accessor.bufferView];
+        if(bufferView.byteStride) stride = bufferView.byteStride;
+        if(!fitsInto(_d->bufferViewData[accessor.bufferView].size(), accessor.byteOffset, accessor.count, stride, size)) {
+            Error{} << prefix << "accessor" << id << "is out of bounds";
+            return false;
+        }
+
+        const std::size_t end = accessor.byteOffset + (accessor.count - 1)*stride + size;
+        base = _d->bufferViewData[accessor.bufferView].slice(accessor.byteOffset, end);
+        if(!accessor.sparse.isSparse) {
+            _d->accessorData[id] = base;
+            _d->accessorLoaded[id] = true;
+            return true;
+        }
+    }
+
+    /* Copy the base view into a tightly packed array or zero-fill it if
+       there's no view. Without a view the count isn't bounded by any data,
+       so check that the size can be calculated. */
+    if(!base && accessor.count > ~std::size_t{}/size) {
+        Error{} << prefix << "accessor" << id << "is too large";
+        return false;
+    }
+    Containers::Array<char> expanded;
+    if(base) {
+        expanded = Containers::Array<char>{Containers::NoInit, accessor.count*size};
+        if(stride == size) std::memcpy(expanded, base, accessor.count*size);
+        else for(std::size_t i = 0; i != accessor.count; ++i)
+            std::memcpy(expanded + i*size, base + i*stride, size);
+    } else expanded = Containers::Array<char>{Containers::ValueInit, accessor.count*size};
+
+    if(accessor.sparse.isSparse && accessor.sparse.count) {
+        std::size_t indexSize;
+        if(accessor.sparse.indices.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+            indexSize = 1;
+        else if(accessor.sparse.indices.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+            indexSize = 2;
+        else if(accessor.sparse.indices.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
+            indexSize = 4;
+        else {
+            Error{} << prefix << "accessor" << id << "has unexpected sparse index type" << accessor.sparse.indices.componentType;
+            return false;
+        }
+
+        if(!loadBufferView(prefix, accessor.sparse.indices.bufferView) ||
+           !loadBufferView(prefix, accessor.sparse.values.bufferView))
+            return false;
+
+        /* Both indices and values are tightly packed */
+        const std::size_t sparseCount = accessor.sparse.count;
+        const Containers::ArrayView<const char> indices = _d->bufferViewData[accessor.sparse.indices.bufferView];
+        const Containers::ArrayView<const char> values = _d->bufferViewData[accessor.sparse.values.bufferView];
+        if(sparseCount > accessor.count ||
+           accessor.sparse.indices.byteOffset < 0 ||
+           accessor.sparse.values.byteOffset < 0 ||
+           !fitsInto(indices.size(), accessor.sparse.indices.byteOffset, sparseCount, indexSize, indexSize) ||
+           !fitsInto(values.size(), accessor.sparse.values.byteOffset, sparseCount, size, size)) {
+            Error{} << prefix << "sparse data of accessor" << id << "are out of bounds";
+            return false;
+        }
+
+        const Containers::ArrayView<const char> sparseIndices = indices.slice(accessor.sparse.indices.byteOffset, accessor.sparse.indices.byteOffset + sparseCount*indexSize);
+        const char* const sparseValues = values + accessor.sparse.values.byteOffset;
+        bool scattered;
+        if(indexSize == 1)
+            scattered = scatterSparse<UnsignedByte>(expanded, accessor.count, size, sparseIndices, sparseValues);
+        else if(indexSize == 2)
+            scattered = scatterSparse<UnsignedShort>(expanded, accessor.count, size, sparseIndices, sparseValues);
+        else
+            scattered = scatterSparse<UnsignedInt>(expanded, accessor.count, size, sparseIndices, sparseValues);
+        if(!scattered) {
+            Error{} << prefix << "sparse index of accessor" << id << "is out of range";
+            return false;
+        }
+    }
+
+    _d->accessorData[id] = expanded;
+    _d->decodedBuffers.push_back(std::move(expanded));
+    _d->accessorLoaded[id] = true;
+    return true;
+}
+
 UnsignedInt TinyGltfImporter::doAnimationCount() const {
     /* If the animations are merged, there's at most one */
     if(configuration().value<bool>("mergeAnimationClips"))
@@ -360,15 +1197,15 @@ Containers::Optional<AnimationData> TinyGltfImporter::doAnimation(UnsignedInt id
         const tinygltf::Animation& animation = _d->model.animations[a];
         for(std::size_t i = 0; i != animation.samplers.size(); ++i) {
             const tinygltf::AnimationSampler& sampler = animation.samplers[i];
-            const tinygltf::Accessor& input = _d->model.accessors[sampler.input];
-            const tinygltf::Accessor& output = _d->model.accessors[sampler.output];
+            if(!loadAccessor("Trade::TinyGltfImporter::animation():", sampler.input) || !loadAccessor("Trade::TinyGltfImporter::animation():", sampler.output))
+                return Containers::NullOpt;
 
             /** @todo handle alignment once we do more than just four-byte types */
 
             /* If the input view is not yet present in the output data buffer, add
             it */
             if(samplerData.find(sampler.input) == samplerData.end()) {
-                Containers::ArrayView<const char> view = bufferView(_d->model, input);
+                Containers::ArrayView<const char> view = accessorView(_d->model, _d->accessorData, sampler.input);
                 samplerData.emplace(sampler.input, std::make_tuple(view, dataSize, ~std::size_t{}));
                 dataSize += view.size();
             }
@@ -376,7 +1213,7 @@ Containers::Optional<AnimationData> TinyGltfImporter::doAnimation(UnsignedInt id
             /* If the output view is not yet present in the output data buffer, add
             it */
             if(samplerData.find(sampler.output) == samplerData.end()) {
-                Containers::ArrayView<const char> view = bufferView(_d->model, output);
+                Containers::ArrayView<const char> view = accessorView(_d->model, _d->accessorData, sampler.output);
                 samplerData.emplace(sampler.output, std::make_tuple(view, dataSize, ~std::size_t{}));
                 dataSize += view.size();
             }
@@ -860,6 +1697,146 @@ std::string TinyGltfImporter::doMesh3DName(const UnsignedInt id) {
     return _d->model.meshes[_d->meshMap[id].first].name;
 }
 
+Containers::Optional<Containers::ArrayView<const char>> TinyGltfImporter::indexView(const char* const prefix, const Int id, MeshIndexType& type) {
+    if(std::size_t(id) >= _d->model.accessors.size()) {
+        Error() << prefix << "index accessor" << id << "out of range for" << _d->model.accessors.size() << "accessors";
+        return Containers::NullOpt;
+    }
+
+    const tinygltf::Accessor& accessor = _d->model.accessors[id];
+    if(accessor.type != TINYGLTF_TYPE_SCALAR) {
+        Error() << prefix << "expected type of index is SCALAR";
+        return Containers::NullOpt;
+    }
+
+    if(accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+        type = MeshIndexType::UnsignedByte;
+    else if(accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+        type = MeshIndexType::UnsignedShort;
+    else if(accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
+        type = MeshIndexType::UnsignedInt;
+    else {
+        Error() << prefix << "unexpected index type" << accessor.componentType;
+        return Containers::NullOpt;
+    }
+
+    if(!loadAccessor(prefix, id))
+        return Containers::NullOpt;
+
+    return accessorView(_d->model, _d->accessorData, id);
+}
+
+Containers::Optional<Containers::ArrayView<const char>> TinyGltfImporter::indexData(const UnsignedInt id, MeshIndexType& type) {
+    CORRADE_ASSERT(isOpened(), "Trade::TinyGltfImporter::indexData(): no file opened", {});
+    CORRADE_ASSERT(id < mesh3DCount(), "Trade::TinyGltfImporter::indexData(): index out of range", {});
+
+    const tinygltf::Primitive& primitive = _d->model.meshes[_d->meshMap[id].first].primitives[_d->meshMap[id].second];
+
+    /* Non-indexed meshes have no index data */
+    if(primitive.indices == -1)
+        return Containers::optional(Containers::ArrayView<const char>{});
+
+    return indexView("Trade::TinyGltfImporter::indexData():", primitive.indices, type);
+}
+
+bool TinyGltfImporter::needsTextureCoordinateYFlip(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::TinyGltfImporter::needsTextureCoordinateYFlip(): no file opened", {});
+    CORRADE_ASSERT(id < mesh3DCount(), "Trade::TinyGltfImporter::needsTextureCoordinateYFlip(): index out of range", {});
+
+    if(!configuration().value<bool>("textureCoordinateYFlipInShader"))
+        return false;
+
+    const tinygltf::Primitive& primitive = _d->model.meshes[_d->meshMap[id].first].primitives[_d->meshMap[id].second];
+    for(const auto& attribute: primitive.attributes)
+        if(Utility::String::beginsWith(attribute.first, "TEXCOORD")) return true;
+
+    return false;
+}
+
+Containers::Optional<Range3D> TinyGltfImporter::meshBounds(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::TinyGltfImporter::meshBounds(): no file opened", {});
+    CORRADE_ASSERT(id < mesh3DCount(), "Trade::TinyGltfImporter::meshBounds(): index out of range", {});
+
+    const tinygltf::Primitive& primitive = _d->model.meshes[_d->meshMap[id].first].primitives[_d->meshMap[id].second];
+    const auto found = primitive.attributes.find("POSITION");
+    if(found == primitive.attributes.end()) {
+        Error() << "Trade::TinyGltfImporter::meshBounds(): mesh" << id << "has no attribute POSITION";
+        return Containers::NullOpt;
+    }
+
+    /* The bounds may come from the accessor metadata without loading it, so
+       check the range here */
+    if(std::size_t(found->second) >= _d->model.accessors.size()) {
+        Error() << "Trade::TinyGltfImporter::meshBounds(): accessor" << found->second << "out of range for" << _d->model.accessors.size() << "accessors";
+        return Containers::NullOpt;
+    }
+
+    const tinygltf::Accessor& accessor = _d->model.accessors[found->second];
+    if(accessor.type != TINYGLTF_TYPE_VEC3) {
+        Error() << "Trade::TinyGltfImporter::meshBounds(): expected type of POSITION is VEC3";
+        return Containers::NullOpt;
+    }
+
+    if(accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT && !isQuantized(accessor.componentType)) {
+        Error() << "Trade::TinyGltfImporter::meshBounds(): vertex attribute POSITION has unexpected type" << accessor.componentType;
+        return Containers::NullOpt;
+    }
+
+    /* The spec requires min and max for positions, use them if present */
+    if(accessor.minValues.size() == 3 && accessor.maxValues.size() == 3) {
+        Range3D bounds;
+        for(std::size_t i = 0; i != 3; ++i) {
+            bounds.min()[i] = boundValue(accessor.minValues[i], accessor.componentType, accessor.normalized);
+            bounds.max()[i] = boundValue(accessor.maxValues[i], accessor.componentType, accessor.normalized);
+        }
+        return bounds;
+    }
+
+    /* Otherwise calculate them from the data */
+    if(!loadAccessor("Trade::TinyGltfImporter::meshBounds():", found->second))
+        return Containers::NullOpt;
+
+    if(!accessor.count) return Range3D{};
+
+    std::vector<Vector3> positions(accessor.count);
+    AttributeExtraction extraction;
+    addAttribute(extraction, _d->model, _d->accessorData, found->second, reinterpret_cast<Float*>(positions.data()), 3);
+    extractAttributes(extraction);
+
+    Range3D bounds{positions.front(), positions.front()};
+    for(const Vector3& position: positions) {
+        bounds.min() = Math::min(bounds.min(), position);
+        bounds.max() = Math::max(bounds.max(), position);
+    }
+    return bounds;
+}
+
+auto TinyGltfImporter::attributeData(const UnsignedInt id, const std::string& name) -> Containers::Optional<PackedAttribute> {
+    CORRADE_ASSERT(isOpened(), "Trade::TinyGltfImporter::attributeData(): no file opened", {});
+    CORRADE_ASSERT(id < mesh3DCount(), "Trade::TinyGltfImporter::attributeData(): index out of range", {});
+
+    const tinygltf::Primitive& primitive = _d->model.meshes[_d->meshMap[id].first].primitives[_d->meshMap[id].second];
+    const auto found = primitive.attributes.find(name);
+    if(found == primitive.attributes.end()) {
+        Error() << "Trade::TinyGltfImporter::attributeData(): mesh" << id << "has no attribute" << name;
+        return Containers::NullOpt;
+    }
+
+    if(!loadAccessor("Trade::TinyGltfImporter::attributeData():", found->second))
+        return Containers::NullOpt;
+
+    /* Sparse accessors are expanded, so the data don't point to the original
+       buffer in that case */
+    const tinygltf::Accessor& accessor = _d->model.accessors[found->second];
+    PackedAttribute attribute;
+    attribute.data = _d->accessorData[found->second];
+    attribute.stride = accessorStride(_d->model, accessor);
+    attribute.componentCount = tinygltf::GetTypeSizeInBytes(accessor.type);
+    attribute.componentType = accessor.componentType;
+    attribute.normalized = accessor.normalized;
+    return attribute;
+}
+
 Containers::Optional<MeshData3D> TinyGltfImporter::doMesh3D(const UnsignedInt id) {
     const tinygltf::Mesh& mesh = _d->model.meshes[_d->meshMap[id].first];
     const tinygltf::Primitive& primitive = mesh.primitives[_d->meshMap[id].second];
@@ -887,37 +1864,41 @@ Containers::Optional<MeshData3D> TinyGltfImporter::doMesh3D(const UnsignedInt id
     }
     /* LCOV_EXCL_STOP */
 
+    /* The attributes are first only validated and the output arrays
+       allocated, the data are copied afterwards in a single pass over each
+       (possibly interleaved) buffer view */
     std::vector<Vector3> positions;
     std::vector<std::vector<Vector3>> normalArrays;
     std::vector<std::vector<Vector2>> textureCoordinateArrays;
     std::vector<std::vector<Color4>> colorArrays;
+    AttributeExtraction extraction;
+    const bool flipTextureCoordinates = !configuration().value<bool>("textureCoordinateYFlipInShader");
     for(auto& attribute: primitive.attributes) {
-        const tinygltf::Accessor& accessor = _d->model.accessors[attribute.second];
-        const tinygltf::BufferView& view = _d->model.bufferViews[accessor.bufferView];
-
-        /* Some of the Khronos sample models have explicitly specified stride
-           (without interleaving), don't fail on that */
-        if(view.byteStride != 0 && view.byteStride != elementSize(accessor)) {
-            Error() << "Trade::TinyGltfImporter::mesh3D(): interleaved buffer views are not supported";
-            return  Containers::NullOpt;
+        if(std::size_t(attribute.second) >= _d->model.accessors.size()) {
+            Error() << "Trade::TinyGltfImporter::mesh3D(): accessor" << attribute.second << "out of range for" << _d->model.accessors.size() << "accessors";
+            return Containers::NullOpt;
         }
 
-        /* At the moment all vertex attributes should have float underlying
-           type */
-        if(accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT) {
+        const tinygltf::Accessor& accessor = _d->model.accessors[attribute.second];
+
+        /* Vertex attributes are either floats or quantized integers
+           (KHR_mesh_quantization), the latter are converted to floats */
+        if(accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT && !isQuantized(accessor.componentType)) {
             Error() << "Trade::TinyGltfImporter::mesh3D(): vertex attribute" << attribute.first << "has unexpected type" << accessor.componentType;
             return Containers::NullOpt;
         }
 
+        if(!loadAccessor("Trade::TinyGltfImporter::mesh3D():", attribute.second))
+            return Containers::NullOpt;
+
         if(attribute.first == "POSITION") {
             if(accessor.type != TINYGLTF_TYPE_VEC3) {
                 Error() << "Trade::TinyGltfImporter::mesh3D(): expected type of" << attribute.first << "is VEC3";
                 return Containers::NullOpt;
             }
 
-            positions.reserve(accessor.count);
-            const auto buffer = bufferView<Vector3>(_d->model, accessor);
-            std::copy(buffer.begin(), buffer.end(), std::back_inserter(positions));
+            positions.resize(accessor.count);
+            addAttribute(extraction, _d->model, _d->accessorData, attribute.second, reinterpret_cast<Float*>(positions.data()), 3);
 
         } else if(attribute.first == "NORMAL") {
             if(accessor.type != TINYGLTF_TYPE_VEC3) {
@@ -925,11 +1906,8 @@ Containers::Optional<MeshData3D> TinyGltfImporter::doMesh3D(const UnsignedInt id
                 return Containers::NullOpt;
             }
 
-            normalArrays.emplace_back();
-            std::vector<Vector3>& normals = normalArrays.back();
-            normals.reserve(accessor.count);
-            const auto buffer = bufferView<Vector3>(_d->model, accessor);
-            std::copy(buffer.begin(), buffer.end(), std::back_inserter(normals));
+            normalArrays.emplace_back(accessor.count);
+            addAttribute(extraction, _d->model, _d->accessorData, attribute.second, reinterpret_cast<Float*>(normalArrays.back().data()), 3);
 
         /* Texture coordinate attribute ends with _0, _1 ... */
         } else if(Utility::String::beginsWith(attribute.first, "TEXCOORD")) {
@@ -938,66 +1916,51 @@ Containers::Optional<MeshData3D> TinyGltfImporter::doMesh3D(const UnsignedInt id
                 return Containers::NullOpt;
             }
 
-            textureCoordinateArrays.emplace_back();
-            std::vector<Vector2>& textureCoordinates = textureCoordinateArrays.back();
-            textureCoordinates.reserve(accessor.count);
-            const auto buffer = bufferView<Vector2>(_d->model, accessor);
-            std::copy(buffer.begin(), buffer.end(), std::back_inserter(textureCoordinates));
+            /* The Y axis is flipped during the copy, unless the user
+               wants to do that in the shader */
+            textureCoordinateArrays.emplace_back(accessor.count);
+            addAttribute(extraction, _d->model, _d->accessorData, attribute.second, reinterpret_cast<Float*>(textureCoordinateArrays.back().data()), 2, flipTextureCoordinates);
 
         /* Color attribute ends with _0, _1 ... */
         } else if(Utility::String::beginsWith(attribute.first, "COLOR")) {
-            colorArrays.emplace_back();
-            std::vector<Color4>& colors = colorArrays.back();
-            colors.reserve(accessor.count);
-
-            if(accessor.type == TINYGLTF_TYPE_VEC3) {
-                colors.reserve(accessor.count);
-                const auto buffer = bufferView<Color3>(_d->model, accessor);
-                std::copy(buffer.begin(), buffer.end(), std::back_inserter(colors));
-
-            } else if(accessor.type == TINYGLTF_TYPE_VEC4) {
-                colors.reserve(accessor.count);
-                const auto buffer = bufferView<Color4>(_d->model, accessor);
-                std::copy(buffer.begin(), buffer.end(), std::back_inserter(colors));
-
-            } else {
+            if(accessor.type != TINYGLTF_TYPE_VEC3 && accessor.type != TINYGLTF_TYPE_VEC4) {
                 Error() << "Trade::TinyGltfImporter::mesh3D(): expected type of" << attribute.first << "is VEC3 or VEC4";
                 return Containers::NullOpt;
             }
 
+            /* Three-component colors are copied into the first three
+               components only, keeping the alpha at 1 */
+            colorArrays.emplace_back(accessor.count, Color4{0.0f, 0.0f, 0.0f, 1.0f});
+            addAttribute(extraction, _d->model, _d->accessorData, attribute.second, reinterpret_cast<Float*>(colorArrays.back().data()), 4);
+
         } else {
             Warning() << "Trade::TinyGltfImporter::mesh3D(): unsupported mesh vertex attribute" << attribute.first;
             continue;
         }
     }
 
+    extractAttributes(extraction);
+
     /* Indices */
     std::vector<UnsignedInt> indices;
     if(primitive.indices != -1) {
-        const tinygltf::Accessor& accessor = _d->model.accessors[primitive.indices];
-
-        if(accessor.type != TINYGLTF_TYPE_SCALAR) {
-            Error() << "Trade::TinyGltfImporter::mesh3D(): expected type of index is SCALAR";
-            return Containers::NullOpt;
+        MeshIndexType type;
+        const Containers::Optional<Containers::ArrayView<const char>> data = indexView("Trade::TinyGltfImporter::mesh3D():", primitive.indices, type);
+        if(!data) return Containers::NullOpt;
+
+        indices.resize(data->size()/meshIndexTypeSize(type));
+        if(type == MeshIndexType::UnsignedByte) {
+            const auto buffer = Containers::arrayCast<const UnsignedByte>(*data);
+            std::copy(buffer.begin(), buffer.end(), indices.begin());
+        } else if(type == MeshIndexType::UnsignedShort) {
+            const auto buffer = Containers::arrayCast<const UnsignedShort>(*data);
+            std::copy(buffer.begin(), buffer.end(), indices.begin());
+        } else {
+            const auto buffer = Containers::arrayCast<const UnsignedInt>(*data);
+            std::copy(buffer.begin(), buffer.end(), indices.begin());
         }
-
-        indices.reserve(accessor.count);
-        if(accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE) {
-            const auto buffer = bufferView<UnsignedByte>(_d->model, accessor);
-            std::copy(buffer.begin(), buffer.end(), std::back_inserter(indices));
-        } else if(accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
-            const auto buffer = bufferView<UnsignedShort>(_d->model, accessor);
-            std::copy(buffer.begin(), buffer.end(), std::back_inserter(indices));
-        } else if(accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
-            const auto buffer = bufferView<UnsignedInt>(_d->model, accessor);
-            std::copy(buffer.begin(), buffer.end(), std::back_inserter(indices));
-        } else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
     }
 
-    /* Flip Y axis of texture coordinates */
-    for(std::vector<Vector2>& layer: textureCoordinateArrays)
-        for(Vector2& c: layer) c.y() = 1.0f - c.y();
-
     return MeshData3D(meshPrimitive, std::move(indices), {std::move(positions)}, std::move(normalArrays), std::move(textureCoordinateArrays), std::move(colorArrays), &mesh);
 }
 
@@ -1276,49 +2239,219 @@ std::string TinyGltfImporter::doImage2DName(const UnsignedInt id) {
     return _d->model.images[id].name;
 }
 
+std::unique_ptr<AbstractImporter> TinyGltfImporter::openImage(const UnsignedInt id, const Containers::ArrayView<const char> data) {
+    const tinygltf::Image& image = _d->model.images[id];
+
+    std::unique_ptr<AbstractImporter> importer{new AnyImageImporter{*manager()}};
+    if(fileCallback()) importer->setFileCallback(fileCallback(), fileCallbackUserData());
+
+    /* External image, otherwise the data come from a buffer view or a
+       decoded data URI */
+    if(!image.uri.empty() && !Utility::String::beginsWith(image.uri, "data:")) {
+        if(!importer->openFile(Utility::Directory::join(_d->filePath, image.uri)))
+            return nullptr;
+    } else if(!importer->openData(data))
+        return nullptr;
+
+    return importer;
+}
+
 Containers::Optional<ImageData2D> TinyGltfImporter::doImage2D(const UnsignedInt id) {
     CORRADE_ASSERT(manager(), "Trade::TinyGltfImporter::image2D(): the plugin must be instantiated with access to plugin manager in order to load images", {});
 
-    /* Because we specified an empty callback for loading image data,
-       Image.image, Image.width, Image.height and Image.component will not be
-       valid and should not be accessed. */
+    /* Image.image, Image.width, Image.height and Image.component are not
+       filled by the parser and should not be accessed. */
 
     const tinygltf::Image& image = _d->model.images[id];
 
-    AnyImageImporter imageImporter{*manager()};
-    if(fileCallback()) imageImporter.setFileCallback(fileCallback(), fileCallbackUserData());
-
-    /* Load embedded image */
-    if(image.uri.empty()) {
-        Containers::ArrayView<const char> data;
+    /* Already decoded by a previous call, return a copy */
+    if(_d->cachedImages[id]) {
+        _d->cachedImageUseOrder.splice(_d->cachedImageUseOrder.begin(), _d->cachedImageUseOrder, _d->cachedImageUse[id]);
+        return copyImage(*_d->cachedImages[id], &image);
+    }
 
-        /* The image data are stored in a buffer */
-        if(image.bufferView != -1) {
-            const tinygltf::BufferView& bufferView = _d->model.bufferViews[image.bufferView];
-            const tinygltf::Buffer& buffer = _d->model.buffers[bufferView.buffer];
+    Containers::Optional<ImageData2D> imageData;
 
-            data = Containers::arrayCast<const char>(Containers::arrayView(&buffer.data[bufferView.byteOffset], bufferView.byteLength));
+    /* Decoded in advance by prefetchImages(), take it over */
+    if(_d->prefetchedImages[id]) {
+        imageData = std::move(_d->prefetchedImages[id]);
+        _d->prefetchedImages[id] = Containers::NullOpt;
+    } else if(!(imageData = decodeImage(id)))
+        return Containers::NullOpt;
 
-        /* Image data were a data URI, the loadImageData() callback copied them
-           without decoding to the internal data vector */
-        } else {
-            data = Containers::arrayCast<const char>(Containers::arrayView(image.image.data(), image.image.size()));
+    /* Keep a copy if it fits into the cache budget, evicting the least
+       recently used images to make room for it */
+    const std::size_t cacheSize = configuration().value<std::size_t>("imageCacheSize");
+    const std::size_t size = imageData->data().size();
+    if(cacheSize && size <= cacheSize) {
+        while(_d->imageCacheUsed + size > cacheSize) {
+            const UnsignedInt oldest = _d->cachedImageUseOrder.back();
+            _d->cachedImageUseOrder.pop_back();
+            _d->imageCacheUsed -= _d->cachedImages[oldest]->data().size();
+            _d->cachedImages[oldest] = Containers::NullOpt;
         }
 
-        Containers::Optional<ImageData2D> imageData;
-        if(!imageImporter.openData(data) || !(imageData = imageImporter.image2D(0)))
+        _d->cachedImages[id] = copyImage(*imageData, &image);
+        _d->cachedImageUse[id] = _d->cachedImageUseOrder.insert(_d->cachedImageUseOrder.begin(), id);
+        _d->imageCacheUsed += size;
+    }
+
+    return imageData;
+}
+
+Containers::Optional<ImageData2D> TinyGltfImporter::decodeImage(const UnsignedInt id) {
+    const tinygltf::Image& image = _d->model.images[id];
+
+    Containers::ArrayView<const char> data;
+    Containers::Optional<Containers::Array<char>> decoded;
+
+    /* The image data are stored in a buffer */
+    if(image.uri.empty()) {
+        if(!loadBufferView("Trade::TinyGltfImporter::image2D():", image.bufferView))
             return Containers::NullOpt;
 
-        return ImageData2D{std::move(*imageData), &image};
+        data = _d->bufferViewData[image.bufferView];
 
-    /* Load external image */
-    } else {
-        Containers::Optional<ImageData2D> imageData;
-        if(!imageImporter.openFile(Utility::Directory::join(_d->filePath, image.uri)) || !(imageData = imageImporter.image2D(0)))
+    /* Data URI, decoded only now as the image might not be needed at all */
+    } else if(Utility::String::beginsWith(image.uri, "data:")) {
+        if(!(decoded = decodeDataUri(image.uri))) {
+            Error{} << "Trade::TinyGltfImporter::image2D(): image" << id << "has an invalid data URI";
             return Containers::NullOpt;
+        }
 
-        return ImageData2D{std::move(*imageData), &image};
+        data = *decoded;
     }
+
+    std::unique_ptr<AbstractImporter> importer = openImage(id, data);
+    Containers::Optional<ImageData2D> imageData;
+    if(!importer || !(imageData = importer->image2D(0)))
+        return Containers::NullOpt;
+
+    return ImageData2D{std::move(*imageData), &image};
+}
+
+bool TinyGltfImporter::prefetchImages(const Containers::ArrayView<const UnsignedInt> ids) {
+    CORRADE_ASSERT(manager(), "Trade::TinyGltfImporter::prefetchImages(): the plugin must be instantiated with access to plugin manager in order to load images", {});
+    CORRADE_ASSERT(isOpened(), "Trade::TinyGltfImporter::prefetchImages(): no file opened", {});
+
+    /* Buffer views are resolved and cached on the calling thread, data URIs
+       are decoded by the workers */
+    struct Job {
+        UnsignedInt id;
+        Containers::ArrayView<const char> data;
+    };
+    std::vector<Job> jobs;
+    std::vector<bool> queued(_d->model.images.size());
+    bool success = true;
+    for(const UnsignedInt id: ids) {
+        CORRADE_ASSERT(id < _d->model.images.size(),
+            "Trade::TinyGltfImporter::prefetchImages(): index" << id << "out of range for" << _d->model.images.size() << "images", {});
+        if(queued[id] || _d->prefetchedImages[id] || _d->cachedImages[id]) continue;
+        queued[id] = true;
+
+        const tinygltf::Image& image = _d->model.images[id];
+        Containers::ArrayView<const char> data;
+        if(image.uri.empty()) {
+            if(!loadBufferView("Trade::TinyGltfImporter::prefetchImages():", image.bufferView)) {
+                success = false;
+                continue;
+            }
+
+            data = _d->bufferViewData[image.bufferView];
+        }
+
+        jobs.push_back({id, data});
+    }
+
+    /* Each image gets its own importer instance. The plugin manager and the
+       file callback are accessed only with the lock held, as neither is
+       thread-safe, so only the actual decoding runs in parallel. Messages
+       printed while processing a job are collected and printed on the
+       calling thread once all workers finish, as output redirection doesn't
+       propagate to the worker threads. */
+    std::mutex mutex;
+    std::atomic<std::size_t> nextJob{0};
+    std::atomic<bool> failed{false};
+    std::vector<std::string> errors(jobs.size()), warnings(jobs.size());
+    auto worker = [&]() {
+        for(std::size_t i; (i = nextJob++) < jobs.size(); ) {
+            const Job& job = jobs[i];
+            const tinygltf::Image& image = _d->model.images[job.id];
+
+            std::ostringstream errorOut, warningOut;
+            {
+                Error redirectError{&errorOut};
+                Warning redirectWarning{&warningOut};
+
+                Containers::ArrayView<const char> data = job.data;
+                Containers::Optional<Containers::Array<char>> decoded;
+                if(Utility::String::beginsWith(image.uri, "data:") && !(decoded = decodeDataUri(image.uri))) {
+                    Error{} << "Trade::TinyGltfImporter::prefetchImages(): image" << job.id << "has an invalid data URI";
+                } else {
+                    if(decoded) data = *decoded;
+
+                    std::unique_ptr<AbstractImporter> importer;
+                    {
+                        std::lock_guard<std::mutex> lock{mutex};
+                        importer = openImage(job.id, data);
+                    }
+
+                    Containers::Optional<ImageData2D> imageData;
+                    if(importer) imageData = importer->image2D(0);
+
+                    {
+                        std::lock_guard<std::mutex> lock{mutex};
+                        importer = nullptr;
+                    }
+
+                    /* Each job writes to a different slot, no need to lock */
+                    if(imageData)
+                        _d->prefetchedImages[job.id] = ImageData2D{std::move(*imageData), &image};
+                }
+            }
+
+            if(!_d->prefetchedImages[job.id]) failed = true;
+            errors[i] = errorOut.str();
+            warnings[i] = warningOut.str();
+        }
+    };
+
+    /* The calling thread is one of the workers. Without thread-local output
+       redirection the messages couldn't be collected, so decode everything
+       on the calling thread in that case. */
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) && defined(CORRADE_BUILD_MULTITHREADED)
+    std::size_t threadCount = configuration().value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    threadCount = std::min(threadCount, jobs.size());
+    std::vector<std::thread> threads;
+    for(std::size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for(std::thread& thread: threads) thread.join();
+    #else
+    worker();
+    #endif
+
+    for(std::size_t i = 0; i != jobs.size(); ++i) {
+        if(!warnings[i].empty())
+            Warning{Warning::Flag::NoNewlineAtTheEnd} << warnings[i];
+        if(!errors[i].empty())
+            Error{Error::Flag::NoNewlineAtTheEnd} << errors[i];
+    }
+
+    return success && !failed;
+}
+
+bool TinyGltfImporter::prefetchImages(const std::initializer_list<UnsignedInt> ids) {
+    return prefetchImages(Containers::ArrayView<const UnsignedInt>{ids.begin(), ids.size()});
+}
+
+bool TinyGltfImporter::prefetchImages() {
+    CORRADE_ASSERT(isOpened(), "Trade::TinyGltfImporter::prefetchImages(): no file opened", {});
+
+    std::vector<UnsignedInt> ids(_d->model.images.size());
+    for(std::size_t i = 0; i != ids.size(); ++i) ids[i] = i;
+    return prefetchImages(Containers::ArrayView<const UnsignedInt>{ids.data(), ids.size()});
 }
 
 const void* TinyGltfImporter::doImporterState() const {
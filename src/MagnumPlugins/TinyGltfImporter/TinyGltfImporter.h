@@ -30,6 +30,9 @@
  * @brief Class @ref Magnum::Trade::TinyGltfImporter
  */
 
+#include <initializer_list>
+#include <Magnum/Mesh.h>
+#include <Magnum/Math/Range.h>
 #include <Magnum/Trade/AbstractImporter.h>
 
 #include "MagnumPlugins/TinyGltfImporter/configure.h"
@@ -61,8 +64,9 @@ namespace Magnum { namespace Trade {
 /**
 @brief TinyGltf importer plugin
 
-Imports glTF and binary glTF using the [TinyGLTF](https://github.com/syoyo/tinygltf)
-library.
+Imports glTF and binary glTF. The data are exposed through the structures of
+the [TinyGLTF](https://github.com/syoyo/tinygltf) library, the JSON is parsed
+with a builtin tokenizer.
 
 This plugin depends on the @ref Trade library and is built if
 `WITH_TINYGLTFIMPORTER` is enabled when building Magnum Plugins. To use as a
@@ -78,13 +82,29 @@ This plugin provides `GltfImporter` and `GlbImporter` plugins.
 @section Trade-TinyGltfImporter-limitations Behavior and limitations
 
 The plugin supports @ref Feature::OpenData and @ref Feature::FileCallback
-features. The `tiny_gltf` library loads everything during initial import,
-meaning all external file loading callbacks are called with
-@ref ImporterFileCallbackPolicy::LoadTemporary and the resources can be safely
-freed right after the @ref openData() / @ref openFile() function exits. In case
-of images, the files are loaded on-demand inside @ref image2D() calls with
-@ref ImporterFileCallbackPolicy::LoadTemporary and @ref ImporterFileCallbackPolicy::Close
-is emitted right after the file is fully read.
+features. The JSON is tokenized in a single pass into a flat array of
+tokens, using SSE2 for skipping whitespace and scanning strings if available,
+and the TinyGLTF structures are filled directly from it without building an
+intermediate document tree. Numbers and escaped strings are converted only
+for properties that are actually used. Buffer data are referenced in place
+instead of being copied. Files opened through
+@ref openFile() are memory-mapped on platforms that support it and the
+binary chunk of a `*.glb` file is accessed directly from the mapped memory;
+in case of @ref openData() only the binary chunk is copied, as there's no
+guarantee the data stay in scope after the function returns. Buffers are
+resolved lazily on first access from @ref mesh3D(), @ref animation() or
+@ref image2D() and cached after that, so opening a file costs roughly just
+the JSON parsing. External buffer files are memory-mapped as well,
+base64-encoded data URIs are decoded once on first access.
+
+If a file callback is set, the main file is loaded with
+@ref ImporterFileCallbackPolicy::LoadPermanent during the initial import and
+external buffer files with the same policy on first access.
+@ref ImporterFileCallbackPolicy::Close is emitted for all of them when the
+file is closed. In case of images, the files are loaded on-demand inside
+@ref image2D() calls with @ref ImporterFileCallbackPolicy::LoadTemporary and
+@ref ImporterFileCallbackPolicy::Close is emitted right after the file is
+fully read.
 
 Import of skeleton, skin and morph data is not supported at the moment.
 
@@ -146,7 +166,33 @@ Import of skeleton, skin and morph data is not supported at the moment.
 
 @subsection Trade-TinyGltfImporter-limitations-meshes Mesh import
 
--   Meshes with interleaved vertex data/buffer views are not supported.
+-   Interleaved vertex data are supported. All attributes stored in the same
+    buffer view are extracted together in a single pass over the view.
+-   The Y axis of texture coordinates is flipped as a part of the copy from
+    the buffer, using SSE2 if available. It's possible to skip the flip
+    using the @cb{.ini} textureCoordinateYFlipInShader @ce option, see
+    @ref Trade-TinyGltfImporter-configuration "below", and query the need
+    to flip with @ref needsTextureCoordinateYFlip().
+-   Quantized vertex attributes (the `KHR_mesh_quantization` extension) are
+    converted to floats, using SSE2 if available. Use @ref attributeData()
+    to access them in the original packed form.
+-   @ref indexData() gives access to the indices in the original type.
+-   @ref meshBounds() returns the bounding box of a mesh from the `min` and
+    `max` properties of its `POSITION` accessor, without loading any
+    buffers. If the properties are missing, the bounds are calculated from
+    the vertex data.
+-   Vertex and index data compressed with the
+    [EXT_meshopt_compression](https://github.com/KhronosGroup/glTF/tree/master/extensions/2.0/Vendor/EXT_meshopt_compression)
+    extension are decoded using a builtin decoder, with SSE2 used for the
+    vertex codec and the exponential filter if available. A compressed buffer
+    view is decoded on first access and cached after that, so only views
+    used by the imported meshes are decoded. @ref indexData() and
+    @ref attributeData() point to the decoded data. The fallback buffers are
+    never loaded.
+-   Sparse accessors are supported, both with and without a base buffer
+    view. The sparse data are applied to an expanded copy of the accessor
+    on first access and the copy is cached after that, @ref attributeData()
+    and @ref indexData() point to it.
 -   Multi-primitive meshes are loaded as follows:
     -   The @ref mesh3DCount() query returns a number of all *primitives*, not
         meshes
@@ -219,6 +265,39 @@ Import of skeleton, skin and morph data is not supported at the moment.
         @ref SamplerMipmap::Linear
     -   Wrapping (all axes): @ref SamplerWrapping::Repeat
 
+@subsection Trade-TinyGltfImporter-limitations-images Image import
+
+-   Images are decoded with @ref AnyImageImporter "AnyImageImporter" one by
+    one inside @ref image2D() calls. Use @ref prefetchImages() to decode
+    a set of images or all of them in parallel on a pool of worker threads,
+    controlled with the @cb{.ini} threads @ce option, see
+    @ref Trade-TinyGltfImporter-configuration "below". Plugin manager access
+    and file callbacks are serialized, so the file callback doesn't need to
+    be thread-safe, only the decoding itself runs in parallel. Errors and
+    warnings from the workers are collected and printed on the calling
+    thread once all images are processed, in the order the images were
+    requested. The images are decoded on a single thread by default, on
+    Emscripten or if Corrade is built without
+    @ref CORRADE_BUILD_MULTITHREADED.
+-   Decoded images can be kept in the importer so repeated @ref image2D()
+    calls for the same image, for example one referenced by several
+    textures, don't decode it again. The cache is disabled by default and
+    its size in bytes is controlled with the @cb{.ini} imageCacheSize @ce
+    option. When the budget is exceeded, the least recently used images are
+    evicted first, images larger than the whole budget are not cached at
+    all. A cache hit saves only the decoding --- the pixel data are still
+    copied on every @ref image2D() call, as the returned @ref ImageData2D
+    owns its data.
+
+@section Trade-TinyGltfImporter-api Plugin-specific API
+
+Besides the @ref AbstractImporter interface, the plugin provides
+@ref indexData(), @ref attributeData(), @ref needsTextureCoordinateYFlip(),
+@ref meshBounds() and @ref prefetchImages(). These functions are virtual in
+order to be callable also on a dynamically loaded plugin instance, without
+linking to it --- just cast the @ref AbstractImporter pointer to
+@ref TinyGltfImporter.
+
 @section Trade-TinyGltfImporter-configuration Plugin-specific config
 
 It's possible to tune various output options through @ref configuration(). See
@@ -234,7 +313,11 @@ importer-specific data accessors:
 -   @ref importerState() returns pointer to the `tinygltf::Model` structure.
     If you use this class statically, you get the concrete type instead of
     a @cpp const void* @ce pointer as returned by
-    @ref AbstractImporter::importerState().
+    @ref AbstractImporter::importerState(). As the buffer data are
+    referenced in place, the `tinygltf::Buffer::data` members are empty.
+    Similarly, `tinygltf::Image::image` is always empty and embedded images
+    keep their data URI in `tinygltf::Image::uri`, decoded only in
+    @ref image2D().
 -   @ref AbstractMaterialData::importerState() returns pointer to the
     `tinygltf::Material` structure
 -   @ref CameraData::importerState() returns pointer to the `tinygltf::Camera`
@@ -259,6 +342,34 @@ this:
 */
 class MAGNUM_TINYGLTFIMPORTER_EXPORT TinyGltfImporter: public AbstractImporter {
     public:
+        /**
+         * @brief Vertex attribute in its original packed form
+         *
+         * @see @ref attributeData()
+         */
+        struct PackedAttribute {
+            /**
+             * Attribute data, starting at the first element and ending
+             * after the last
+             */
+            Containers::ArrayView<const char> data;
+
+            /** Stride between consecutive elements, in bytes */
+            UnsignedInt stride;
+
+            /** Component count */
+            UnsignedInt componentCount;
+
+            /**
+             * glTF component type, for example @cpp 5122 @ce for
+             * `SHORT` or @cpp 5126 @ce for `FLOAT`
+             */
+            Int componentType;
+
+            /** Whether the components are normalized */
+            bool normalized;
+        };
+
         /**
          * @brief Default constructor
          *
@@ -290,6 +401,112 @@ class MAGNUM_TINYGLTFIMPORTER_EXPORT TinyGltfImporter: public AbstractImporter {
             return static_cast<const tinygltf::Model*>(AbstractImporter::importerState());
         }
 
+        /**
+         * @brief Mesh index data in the original type
+         * @param[in]  id    Mesh ID, from range [0, @ref mesh3DCount())
+         * @param[out] type  Index type
+         *
+         * While @ref mesh3D() always widens the indices to
+         * @ref Magnum::UnsignedInt "UnsignedInt", this function returns a
+         * view directly on the buffer data, with @p type set to the type
+         * the indices are stored in. No data are copied, so 8- and 16-bit
+         * index buffers can be uploaded as-is. The view is valid until the
+         * file is closed.
+         *
+         * Returns an empty view for non-indexed meshes, @p type is left
+         * untouched in that case. Returns @ref Containers::NullOpt on
+         * failure. Expects that a file is opened.
+         */
+        virtual Containers::Optional<Containers::ArrayView<const char>> indexData(UnsignedInt id, MeshIndexType& type);
+
+        /**
+         * @brief Vertex attribute data in the original packed form
+         * @param id    Mesh ID, from range [0, @ref mesh3DCount())
+         * @param name  glTF attribute name, such as @cpp "POSITION" @ce or
+         *      @cpp "TEXCOORD_0" @ce
+         *
+         * While @ref mesh3D() always converts the vertex attributes to
+         * floats, this function returns a view directly on the buffer data
+         * together with a description of the format, so quantized data
+         * (`KHR_mesh_quantization`) can be uploaded to the GPU as-is. No
+         * data are copied and the texture coordinates are not flipped. The
+         * view is valid until the file is closed.
+         *
+         * Returns @ref Containers::NullOpt if the mesh doesn't have given
+         * attribute or on failure. Expects that a file is opened.
+         */
+        virtual Containers::Optional<PackedAttribute> attributeData(UnsignedInt id, const std::string& name);
+
+        /**
+         * @brief Whether texture coordinates of a mesh need a Y flip
+         * @param id    Mesh ID, from range [0, @ref mesh3DCount())
+         *
+         * glTF has the texture coordinate origin in the top left corner,
+         * while Magnum in the bottom left. By default @ref mesh3D() flips
+         * the Y axis of texture coordinates during import and this function
+         * returns @cpp false @ce. If the
+         * @cb{.ini} textureCoordinateYFlipInShader @ce option is enabled,
+         * the texture coordinates are imported unchanged and this function
+         * returns @cpp true @ce for meshes that have any, meaning the
+         * renderer is expected to use @cpp 1.0 - y @ce instead of
+         * @cpp y @ce. The result reflects the current configuration, so
+         * query it with the same options as were used for @ref mesh3D().
+         *
+         * Expects that a file is opened.
+         */
+        virtual bool needsTextureCoordinateYFlip(UnsignedInt id);
+
+        /**
+         * @brief Mesh bounds
+         * @param id    Mesh ID, from range [0, @ref mesh3DCount())
+         *
+         * Returns the axis-aligned bounding box of mesh positions, as stored
+         * in the `min` and `max` properties of the `POSITION` accessor. No
+         * buffers are loaded in that case, so it's cheap to query bounds of
+         * all meshes right after opening a file. The properties are required
+         * by the glTF spec, if they're missing anyway, the bounds are
+         * calculated from the vertex data. Quantized positions are
+         * normalized the same way as in @ref mesh3D(). The bounds are in
+         * the mesh local space, with no node transformation applied.
+         *
+         * Returns @ref Containers::NullOpt if the mesh has no positions or
+         * on failure. Expects that a file is opened.
+         */
+        virtual Containers::Optional<Range3D> meshBounds(UnsignedInt id);
+
+        /**
+         * @brief Decode images in advance
+         * @param ids   Image IDs, from range [0, @ref image2DCount())
+         * @return @cpp true @ce if all images were decoded successfully,
+         *      @cpp false @ce otherwise
+         *
+         * Decodes given images in parallel on a pool of worker threads, each
+         * image with its own importer instance. Thread count is controlled
+         * with the @cb{.ini} threads @ce option, see
+         * @ref Trade-TinyGltfImporter-configuration "class documentation".
+         * A subsequent @ref image2D() call for any of these IDs returns the
+         * already decoded image, which is not kept in the importer after
+         * that unless it fits into the image cache, see the
+         * @cb{.ini} imageCacheSize @ce option. Images that are already
+         * decoded or cached are skipped. Images that failed to decode are
+         * not kept and @ref image2D() will attempt to decode them again.
+         *
+         * Expects that a file is opened and the plugin has access to plugin
+         * manager.
+         */
+        virtual bool prefetchImages(Containers::ArrayView<const UnsignedInt> ids);
+
+        /** @overload */
+        bool prefetchImages(std::initializer_list<UnsignedInt> ids);
+
+        /**
+         * @brief Decode all images in advance
+         *
+         * Equivalent to calling @ref prefetchImages(Containers::ArrayView<const UnsignedInt>)
+         * with all IDs from range [0, @ref image2DCount()).
+         */
+        bool prefetchImages();
+
     private:
         struct Document;
 
@@ -301,6 +518,13 @@ class MAGNUM_TINYGLTFIMPORTER_EXPORT TinyGltfImporter: public AbstractImporter {
         MAGNUM_TINYGLTFIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_TINYGLTFIMPORTER_LOCAL void doClose() override;
 
+        MAGNUM_TINYGLTFIMPORTER_LOCAL bool loadBuffer(const char* prefix, Int buffer);
+        MAGNUM_TINYGLTFIMPORTER_LOCAL bool loadBufferView(const char* prefix, Int bufferView);
+        MAGNUM_TINYGLTFIMPORTER_LOCAL bool loadAccessor(const char* prefix, Int accessor);
+        MAGNUM_TINYGLTFIMPORTER_LOCAL Containers::Optional<Containers::ArrayView<const char>> indexView(const char* prefix, Int accessor, MeshIndexType& type);
+        MAGNUM_TINYGLTFIMPORTER_LOCAL std::unique_ptr<AbstractImporter> openImage(UnsignedInt id, Containers::ArrayView<const char> data);
+        MAGNUM_TINYGLTFIMPORTER_LOCAL Containers::Optional<ImageData2D> decodeImage(UnsignedInt id);
+
         MAGNUM_TINYGLTFIMPORTER_LOCAL UnsignedInt doAnimationCount() const override;
         MAGNUM_TINYGLTFIMPORTER_LOCAL std::string doAnimationName(UnsignedInt id) override;
         MAGNUM_TINYGLTFIMPORTER_LOCAL Int doAnimationForName(const std::string& name) override;